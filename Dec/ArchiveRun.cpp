@@ -0,0 +1,166 @@
+#include "ArchiveRun.h"
+#include "Instrumentation.h"
+#include <iostream>
+#include <cstring>
+#include <filesystem>
+
+using namespace std;
+
+void ecrireVarint(vector<uint8_t>& sortie, uint64_t valeur) {
+    while (valeur >= 0x80) {
+        sortie.push_back((uint8_t)(valeur | 0x80));
+        valeur >>= 7;
+    }
+    sortie.push_back((uint8_t)valeur);
+}
+
+bool lireVarint(const uint8_t*& debut, const uint8_t* fin, uint64_t& valeur) {
+    valeur = 0;
+    for (int decalage = 0; debut < fin && decalage < 64; decalage += 7) {
+        uint8_t octet = *debut++;
+        valeur |= (uint64_t)(octet & 0x7F) << decalage;
+        if (!(octet & 0x80)) return true;
+    }
+    return false;
+}
+
+ArchiveRun::ArchiveRun() : nbLignes(0), nbColonnes(0), intervalleCles(64), depuisCle(0) {}
+
+ArchiveRun::~ArchiveRun() { fermer(); }
+
+bool ArchiveRun::estOuverte() const { return fichier.is_open(); }
+
+void ArchiveRun::ouvrir(const string& chemin, int lignes, int colonnes, int intervalle) {
+    fermer();
+    fichier.open(chemin, ios::binary | ios::trunc);
+    if (!fichier.is_open()) {
+        cerr << "Erreur : Impossible de creer l'archive " << chemin << endl;
+        exit(1);
+    }
+    nbLignes = lignes;
+    nbColonnes = colonnes;
+    intervalleCles = intervalle > 0 ? intervalle : 1;
+    depuisCle = 0;
+    precedent.redimensionner(0, 0);
+    index.clear();
+
+    tampon.clear();
+    for (char c : MAGIC_ARCHIVE) tampon.push_back((uint8_t)c);
+    ecrireFixe<uint32_t>(tampon, VERSION_ARCHIVE);
+    ecrireFixe<int32_t>(tampon, nbLignes);
+    ecrireFixe<int32_t>(tampon, nbColonnes);
+    ecrireFixe<uint32_t>(tampon, (uint32_t)intervalleCles);
+    fichier.write((const char*)tampon.data(), tampon.size());
+    COMPTER(Compteur::OctetsEcrits, tampon.size());
+}
+
+// Continue une archive interrompue : tout ce qui suit le point de reprise est tronqué,
+// puis l'écriture repart avec l'état sauvegardé (même delta, même index qu'une exécution sans arrêt)
+void ArchiveRun::reprendre(const string& chemin, const EtatArchive& etat, int lignes, int colonnes, int intervalle) {
+    fermer();
+    error_code erreur;
+    uint64_t taille = std::filesystem::file_size(chemin, erreur);
+    if (erreur || taille < etat.taille) {
+        cerr << "Erreur : Archive " << chemin << " absente ou plus courte que le point de reprise" << endl;
+        exit(1);
+    }
+    std::filesystem::resize_file(chemin, etat.taille, erreur);
+    fichier.open(chemin, ios::binary | ios::in | ios::out); // Sans troncature
+    if (erreur || !fichier.is_open()) {
+        cerr << "Erreur : Impossible de reprendre l'archive " << chemin << endl;
+        exit(1);
+    }
+    fichier.seekp(0, ios::end);
+    nbLignes = lignes;
+    nbColonnes = colonnes;
+    intervalleCles = intervalle > 0 ? intervalle : 1;
+    depuisCle = etat.depuisCle;
+    precedent = etat.precedent;
+    index = etat.index;
+}
+
+void ArchiveRun::capturer(EtatArchive& etat) {
+    if (!fichier.is_open()) return;
+    fichier.flush();
+    etat.taille = (uint64_t)fichier.tellp();
+    etat.depuisCle = depuisCle;
+    etat.precedent = precedent;
+    etat.index = index;
+}
+
+void ArchiveRun::ecrireEnregistrement(uint8_t type, long long generation) {
+    index.push_back({generation, (uint64_t)fichier.tellp(), type});
+    entete.clear();
+    entete.push_back(type);
+    ecrireVarint(entete, (uint64_t)generation);
+    ecrireVarint(entete, tampon.size());
+    fichier.write((const char*)entete.data(), entete.size());
+    fichier.write((const char*)tampon.data(), tampon.size());
+    COMPTER(Compteur::OctetsEcrits, entete.size() + tampon.size());
+}
+
+void ArchiveRun::ajouter(long long generation, const GrilleBits& etat) {
+    if (!fichier.is_open()) return;
+    const int mots = etat.getMotsParLigne();
+    const size_t tailleCle = (size_t)nbLignes * mots * sizeof(uint64_t);
+    tampon.clear();
+
+    // Delta : positions des cellules qui diffèrent de l'enregistrement précédent, en écarts croissants
+    bool cle = depuisCle >= intervalleCles || precedent.getNbLignes() != nbLignes;
+    if (!cle) {
+        uint64_t derniere = 0;
+        size_t nombre = 0;
+        for (int i = 0; i < nbLignes && !cle; ++i) {
+            const uint64_t* a = etat.ligne(i);
+            const uint64_t* b = precedent.ligne(i);
+            for (int k = 0; k < mots; ++k) {
+                for (uint64_t diff = a[k] ^ b[k]; diff; diff &= diff - 1) {
+                    uint64_t position = (uint64_t)i * nbColonnes + 64 * k + __builtin_ctzll(diff);
+                    ecrireVarint(tampon, position - derniere);
+                    derniere = position;
+                    ++nombre;
+                }
+            }
+            if (tampon.size() >= tailleCle) cle = true; // Un delta plus gros qu'une image clé n'a pas d'intérêt
+        }
+        if (!cle) {
+            entete.clear();
+            ecrireVarint(entete, nombre);
+            tampon.insert(tampon.begin(), entete.begin(), entete.end());
+            ecrireEnregistrement(ENREGISTREMENT_DELTA, generation);
+            ++depuisCle;
+        }
+    }
+
+    if (cle) {
+        tampon.resize(tailleCle);
+        for (int i = 0; i < nbLignes; ++i) {
+            memcpy(tampon.data() + (size_t)i * mots * sizeof(uint64_t), etat.ligne(i), mots * sizeof(uint64_t));
+        }
+        ecrireEnregistrement(ENREGISTREMENT_CLE, generation);
+        depuisCle = 1;
+    }
+    precedent = etat;
+}
+
+void ArchiveRun::vider() {
+    if (fichier.is_open()) fichier.flush();
+}
+
+void ArchiveRun::fermer() {
+    if (!fichier.is_open()) return;
+    uint64_t positionIndex = (uint64_t)fichier.tellp();
+    tampon.clear();
+    for (const EntreeIndex& entree : index) {
+        ecrireFixe<int64_t>(tampon, entree.generation);
+        ecrireFixe<uint64_t>(tampon, entree.position);
+        tampon.push_back(entree.type);
+    }
+    ecrireFixe<uint64_t>(tampon, positionIndex);
+    ecrireFixe<uint64_t>(tampon, (uint64_t)index.size());
+    for (char c : MAGIC_INDEX) tampon.push_back((uint8_t)c);
+    fichier.write((const char*)tampon.data(), tampon.size());
+    COMPTER(Compteur::OctetsEcrits, tampon.size());
+    fichier.close();
+    index.clear();
+}
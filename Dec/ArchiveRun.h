@@ -0,0 +1,90 @@
+#ifndef ARCHIVERUN_H
+#define ARCHIVERUN_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include "GrilleBits.h"
+
+// Archive binaire d'une simulation : un seul fichier par exécution.
+// En-tête : "JDVA", version, dimensions, intervalle entre images clés.
+// Enregistrements : type (image clé ou delta), génération, taille, contenu.
+//   - image clé : les mots de 64 bits de la grille, ligne après ligne ;
+//   - delta : cellules basculées depuis l'enregistrement précédent, positions (ligne * colonnes + colonne)
+//     croissantes codées par écarts en entiers de longueur variable.
+// Index à la fermeture : (génération, position, type) de chaque enregistrement, puis sa position et "JDVI".
+// Une archive sans index (exécution interrompue) reste lisible en parcourant les enregistrements.
+
+const char MAGIC_ARCHIVE[4] = {'J', 'D', 'V', 'A'};
+const char MAGIC_INDEX[4] = {'J', 'D', 'V', 'I'};
+const uint32_t VERSION_ARCHIVE = 1;
+const uint8_t ENREGISTREMENT_CLE = 0;
+const uint8_t ENREGISTREMENT_DELTA = 1;
+
+// Entrée de l'index : où trouver une génération
+struct EntreeIndex {
+    long long generation;
+    uint64_t position;  // Position de l'enregistrement dans le fichier
+    uint8_t type;       // ENREGISTREMENT_CLE ou ENREGISTREMENT_DELTA
+};
+
+void ecrireVarint(std::vector<uint8_t>& sortie, uint64_t valeur);
+bool lireVarint(const uint8_t*& debut, const uint8_t* fin, uint64_t& valeur); // Faux si les données sont tronquées
+
+// Entiers de taille fixe (petit-boutiste), partagés avec les points de reprise
+template <typename T>
+inline void ecrireFixe(std::vector<uint8_t>& sortie, T valeur) {
+    uint8_t octets[sizeof(T)];
+    std::memcpy(octets, &valeur, sizeof(T));
+    sortie.insert(sortie.end(), octets, octets + sizeof(T));
+}
+template <typename T>
+inline T lireFixe(const uint8_t* octets) {
+    T valeur;
+    std::memcpy(&valeur, octets, sizeof(T));
+    return valeur;
+}
+template <typename T>
+inline bool lireFixe(const uint8_t*& debut, const uint8_t* fin, T& valeur) { // Faux si les données sont tronquées
+    if (fin - debut < (std::ptrdiff_t)sizeof(T)) return false;
+    valeur = lireFixe<T>(debut);
+    debut += sizeof(T);
+    return true;
+}
+
+// État de l'écriture d'une archive, conservé dans un point de reprise pour la continuer à l'identique
+struct EtatArchive {
+    uint64_t taille = 0;            // Octets des enregistrements complets (l'archive est tronquée à cette taille)
+    int depuisCle = 0;
+    GrilleBits precedent;
+    std::vector<EntreeIndex> index;
+};
+
+class ArchiveRun {
+private:
+    std::ofstream fichier;
+    int nbLignes, nbColonnes;
+    int intervalleCles;             // Une image clé au moins tous les N enregistrements
+    int depuisCle;                  // Enregistrements écrits depuis la dernière image clé
+    GrilleBits precedent;           // Dernière génération enregistrée (base du prochain delta)
+    std::vector<EntreeIndex> index;
+    std::vector<uint8_t> tampon;    // Contenu de l'enregistrement en cours
+    std::vector<uint8_t> entete;    // En-tête de l'enregistrement en cours (réutilisé)
+
+    void ecrireEnregistrement(uint8_t type, long long generation);
+
+public:
+    ArchiveRun();
+    ~ArchiveRun();
+    void ouvrir(const std::string& chemin, int nbLignes, int nbColonnes, int intervalleCles = 64);
+    void reprendre(const std::string& chemin, const EtatArchive& etat, int nbLignes, int nbColonnes, int intervalleCles);
+    void ajouter(long long generation, const GrilleBits& etat); // Générations croissantes
+    void capturer(EtatArchive& etat); // Vide le tampon puis copie l'état d'écriture
+    void vider();  // Transmet au système les enregistrements en attente
+    void fermer(); // Écrit l'index ; appelé aussi par le destructeur
+    bool estOuverte() const;
+};
+
+#endif // ARCHIVERUN_H
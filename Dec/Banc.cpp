@@ -0,0 +1,287 @@
+// Banc d'essai des moteurs : chaque moteur est mesuré sans affichage sur un jeu fixe de configurations.
+// Chaque cas s'exécute dans un processus fils : le pic de mémoire et le nombre d'allocations
+// sont ceux du cas seul, et un moteur qui échoue n'interrompt pas le banc.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "Moteur.h"
+#include "MoteurParallele.h"
+#include "GrilleBits.h"
+#include "Chargeur.h"
+#include "Mesures.h"
+#include "BancAnciens.h"
+
+using namespace std;
+
+// Configuration initiale mesurée
+struct Cas {
+    string graine;     // soupe_10, soupe_30, soupe_50, clairsemee, r_pentomino, canon_gosper
+    int taille;        // Tore carré taille x taille
+    long long generations;
+};
+
+const int MAX_NOEUDS = 8; // Nœuds NUMA rapportés par le banc
+
+struct Resultat {
+    long long generations = 0;
+    double secondes = 0;
+    long long memoireKo = 0;
+    long long allocations = 0;
+    long long allocationsRegime = 0; // Après la mise en route (premier dixième des générations)
+    long long population = 0;
+    long long octets = -1;           // Trafic estimé de la grille complète, -1 si le moteur ne l'estime pas
+    int nbNoeuds = 0;                // Moteur parallèle : cellules calculées par les travailleurs de chaque nœud
+    long long cellulesNoeud[MAX_NOEUDS] = {};
+};
+
+static const char* R_PENTOMINO = "x = 3, y = 3\nb2o$2o$bo!\n";
+static const char* CANON_GOSPER =
+    "x = 36, y = 9\n24bo$22bobo$12b2o6b2o12b2o$11bo3bo4b2o12b2o$2o8bo5bo3b2o$2o8bo3bob2o4bobo$10bo5bo7bo$11bo3bo$12b2o!\n";
+
+static void construire(const Cas& cas, GrilleBits& etat) {
+    if (cas.graine == "r_pentomino" || cas.graine == "canon_gosper") {
+        const char* motif = cas.graine == "r_pentomino" ? R_PENTOMINO : CANON_GOSPER;
+        Chargeur chargeur(motif, strlen(motif), cas.taille, cas.taille);
+        chargeur.charger(etat, FormatMotif::RLE);
+        return;
+    }
+    double densite = cas.graine == "clairsemee" ? 0.01 : stoi(cas.graine.substr(6)) / 100.0;
+    etat.redimensionner(cas.taille, cas.taille);
+    mt19937_64 generateur(12345 + cas.taille); // Graines fixes : mêmes configurations d'une exécution à l'autre
+    bernoulli_distribution tirage(densite);
+    for (int i = 0; i < cas.taille; ++i) {
+        for (int j = 0; j < cas.taille; ++j) {
+            if (tirage(generateur)) etat.set(i, j, true);
+        }
+    }
+}
+
+// Jeu fixe de cas : le nombre de générations diminue avec la taille pour garder des durées comparables
+static vector<Cas> listeCas(int tailleMax) {
+    vector<Cas> cas;
+    auto generations = [](int taille) {
+        long long n = (1LL << 30) / ((long long)taille * taille);
+        return max(4LL, min(2000LL, n));
+    };
+    for (int taille : {64, 256, 1024, 4096, 16384}) {
+        if (taille > tailleMax) continue;
+        for (const char* graine : {"soupe_10", "soupe_30", "soupe_50"}) cas.push_back({graine, taille, generations(taille)});
+        if (taille >= 1024) cas.push_back({"clairsemee", taille, generations(taille)});
+        if (taille >= 256) cas.push_back({"canon_gosper", taille, generations(taille)});
+        if (taille >= 1024) cas.push_back({"r_pentomino", taille, 2000});
+    }
+    return cas;
+}
+
+// Combinaisons trop lentes ou trop gourmandes pour un moteur : ignorées plutôt que de bloquer le banc
+static bool admissible(const string& moteur, const Cas& cas, long long population) {
+    long long cellules = (long long)cas.taille * cas.taille;
+    if (moteur == "evan" || moteur == "multithreads") return cellules <= 256 * 256; // Historique de chaînes : O(cellules) par génération
+    if (moteur == "creux") return population <= 200000;
+    if (moteur == "hashlife") return cellules <= 4096LL * 4096 || population <= 200000;
+    return true;
+}
+
+static vector<Candidat> candidats(int profondeur) {
+    vector<Candidat> liste;
+    for (const char* nom : {"creux", "dense", "parallele", "hashlife", "table", "hybride"}) {
+        TypeMoteur type;
+        lireTypeMoteur(nom, type);
+        auto moteur = make_shared<unique_ptr<Moteur>>();
+        liste.push_back({nom,
+                         [moteur, type, profondeur](const GrilleBits& etat) {
+                             *moteur = creerMoteur(type);
+                             (*moteur)->setProfondeur(profondeur);
+                             (*moteur)->charger(etat);
+                         },
+                         [moteur](long long n) { (*moteur)->avancer(n); },
+                         [moteur]() { return (*moteur)->octetsGrilleEstimes(); },
+                         [moteur](vector<long long>& cellules) {
+                             if (auto* parallele = dynamic_cast<const MoteurParallele*>(moteur->get())) parallele->cellulesParNoeud(cellules);
+                         }});
+    }
+#ifdef BANC_ANCIENS
+    for (Candidat& ancien : programmesAnciens()) liste.push_back(ancien);
+#endif
+    return liste;
+}
+
+// Exécuté dans le processus fils. Hashlife avance d'un seul appel ; les autres génération par génération
+// (par 16 passages de blocage temporel avec --profondeur), jusqu'à la limite de temps.
+static Resultat mesurer(Candidat& candidat, const Cas& cas, const GrilleBits& etat, double limiteSecondes, int profondeur) {
+    Resultat resultat;
+    candidat.charger(etat);
+    const bool parEtapes = candidat.nom != "hashlife";
+    long long tranche = !parEtapes ? cas.generations : profondeur > 1 ? 16LL * profondeur : 1;
+
+    const long long miseEnRoute = max(1LL, cas.generations / 10); // Tampons agrandis jusqu'à la population maximale
+    long long allocationsAvant = nombreAllocations(), allocationsRoute = -1;
+    auto debut = chrono::steady_clock::now();
+    while (resultat.generations < cas.generations) {
+        long long pas = min(tranche, cas.generations - resultat.generations);
+        candidat.avancer(pas);
+        resultat.generations += pas;
+        if (allocationsRoute < 0 && resultat.generations >= miseEnRoute) allocationsRoute = nombreAllocations();
+        resultat.secondes = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+        if (resultat.secondes > limiteSecondes) break;
+    }
+    resultat.allocations = nombreAllocations() - allocationsAvant;
+    if (parEtapes && allocationsRoute >= 0) resultat.allocationsRegime = nombreAllocations() - allocationsRoute;
+    resultat.memoireKo = memoireMaxKo();
+    if (candidat.octets) resultat.octets = candidat.octets();
+    vector<long long> cellules;
+    if (candidat.cellulesParNoeud) candidat.cellulesParNoeud(cellules);
+    resultat.nbNoeuds = min((int)cellules.size(), MAX_NOEUDS);
+    for (int n = 0; n < resultat.nbNoeuds; ++n) resultat.cellulesNoeud[n] = cellules[n];
+    return resultat;
+}
+
+// Lance la mesure dans un processus fils et lit son résultat dans un tube
+static bool mesurerIsole(Candidat& candidat, const Cas& cas, const GrilleBits& etat, double limiteSecondes, int profondeur,
+                         Resultat& resultat) {
+    int tube[2];
+    if (pipe(tube) != 0) return false;
+    cout.flush();
+    pid_t fils = fork();
+    if (fils < 0) return false;
+    if (fils == 0) {
+        close(tube[0]);
+        Resultat mesure = mesurer(candidat, cas, etat, limiteSecondes, profondeur);
+        ssize_t ecrits = write(tube[1], &mesure, sizeof(mesure));
+        _exit(ecrits == (ssize_t)sizeof(mesure) ? 0 : 1);
+    }
+    close(tube[1]);
+    ssize_t lus = read(tube[0], &resultat, sizeof(resultat));
+    close(tube[0]);
+    int statut = 0;
+    waitpid(fils, &statut, 0);
+    return lus == (ssize_t)sizeof(resultat) && WIFEXITED(statut) && WEXITSTATUS(statut) == 0;
+}
+
+static void afficherUsageBanc(const string& programme) {
+    cout << "Usage : " << programme << " [options]\n"
+         << "  --moteurs A,B,...  moteurs mesures (defaut : tous)\n"
+         << "  --taille-max N     plus grande taille de tore mesuree (defaut 16384)\n"
+         << "  --limite S         duree maximale d'un cas en secondes (defaut 20)\n"
+         << "  --format F         csv (defaut) ou json\n"
+         << "  --sortie FICHIER   ecrit le rapport dans un fichier au lieu de la sortie standard\n"
+         << "  --profondeur K     blocage temporel des moteurs dense, parallele et hybride : K generations par passage\n"
+         << "                     de la grille (defaut 1 : aucun)\n"
+         << "  --verifier-allocations  echoue si un moteur alloue apres le premier dixieme des generations\n"
+         << "  --aide             affiche ce message" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    string moteursDemandes, format = "csv", sortie;
+    int tailleMax = 16384;
+    int profondeur = 1;
+    double limiteSecondes = 20;
+    bool verifierAllocations = false;
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--verifier-allocations") {
+            verifierAllocations = true;
+            continue;
+        }
+        if (option == "--aide" || i + 1 >= argc) {
+            afficherUsageBanc(argv[0]);
+            return option == "--aide" ? 0 : 1;
+        }
+        string valeur = argv[++i];
+        if (option == "--moteurs") moteursDemandes = "," + valeur + ",";
+        else if (option == "--taille-max") tailleMax = stoi(valeur);
+        else if (option == "--limite") limiteSecondes = stod(valeur);
+        else if (option == "--profondeur" && stoi(valeur) > 0) profondeur = stoi(valeur);
+        else if (option == "--format" && (valeur == "csv" || valeur == "json")) format = valeur;
+        else if (option == "--sortie") sortie = valeur;
+        else {
+            afficherUsageBanc(argv[0]);
+            return 1;
+        }
+    }
+
+    ofstream fichier;
+    if (!sortie.empty()) {
+        fichier.open(sortie);
+        if (!fichier.is_open()) {
+            cerr << "Erreur : Impossible de creer " << sortie << endl;
+            return 1;
+        }
+    }
+    ostream& rapport = sortie.empty() ? cout : fichier;
+
+    if (format == "csv") {
+        rapport << "moteur,graine,lignes,colonnes,generations,secondes,generations_par_s,cellules_par_s,rss_max_ko,allocations_par_generation,octets_grille_estimes_par_generation,"
+                   "cellules_par_s_par_noeud" << endl;
+    } else {
+        rapport << "[";
+    }
+
+    vector<Candidat> liste = candidats(profondeur);
+    bool premier = true;
+    bool echecAllocations = false; // --verifier-allocations : au moins un moteur a alloué en régime établi
+    GrilleBits etat;
+    for (const Cas& cas : listeCas(tailleMax)) {
+        construire(cas, etat);
+        long long population = etat.population();
+        for (Candidat& candidat : liste) {
+            if (!moteursDemandes.empty() && moteursDemandes.find("," + candidat.nom + ",") == string::npos) continue;
+            if (!admissible(candidat.nom, cas, population)) continue;
+
+            Resultat resultat;
+            if (!mesurerIsole(candidat, cas, etat, limiteSecondes, profondeur, resultat)) {
+                cerr << "Echec : " << candidat.nom << " sur " << cas.graine << " " << cas.taille << "x" << cas.taille << endl;
+                continue;
+            }
+            if (verifierAllocations && resultat.allocationsRegime > 0) {
+                cerr << "Allocations en regime etabli : " << candidat.nom << " sur " << cas.graine << " " << cas.taille << "x"
+                     << cas.taille << " : " << resultat.allocationsRegime << endl;
+                echecAllocations = true;
+            }
+            double s = resultat.secondes > 0 ? resultat.secondes : 1e-9;
+            double generationsParS = resultat.generations / s;
+            double cellulesParS = generationsParS * cas.taille * (double)cas.taille;
+            double allocationsParGeneration = resultat.generations ? (double)resultat.allocations / resultat.generations : 0;
+            double octetsParGeneration = resultat.octets < 0 ? -1 : resultat.generations ? (double)resultat.octets / resultat.generations : 0;
+            ostringstream parNoeud; // Débit de chaque socket, séparé par des points-virgules (CSV) ou des virgules (JSON)
+            parNoeud << fixed << setprecision(0);
+            for (int n = 0; n < resultat.nbNoeuds; ++n) {
+                parNoeud << (n ? (format == "csv" ? ";" : ", ") : "") << resultat.cellulesNoeud[n] / s;
+            }
+
+            rapport << fixed;
+            if (format == "csv") {
+                rapport << candidat.nom << "," << cas.graine << "," << cas.taille << "," << cas.taille << ","
+                        << resultat.generations << "," << setprecision(4) << resultat.secondes << ","
+                        << setprecision(1) << generationsParS << "," << setprecision(0) << cellulesParS << ","
+                        << resultat.memoireKo << "," << setprecision(2) << allocationsParGeneration << ","
+                        << setprecision(0) << octetsParGeneration << "," << parNoeud.str() << endl;
+            } else {
+                rapport << (premier ? "\n" : ",\n")
+                        << "  {\"moteur\": \"" << candidat.nom << "\", \"graine\": \"" << cas.graine
+                        << "\", \"lignes\": " << cas.taille << ", \"colonnes\": " << cas.taille
+                        << ", \"generations\": " << resultat.generations
+                        << ", \"secondes\": " << setprecision(4) << resultat.secondes
+                        << ", \"generations_par_s\": " << setprecision(1) << generationsParS
+                        << ", \"cellules_par_s\": " << setprecision(0) << cellulesParS
+                        << ", \"rss_max_ko\": " << resultat.memoireKo
+                        << ", \"allocations_par_generation\": " << setprecision(2) << allocationsParGeneration
+                        << ", \"octets_grille_estimes_par_generation\": " << setprecision(0) << octetsParGeneration
+                        << ", \"cellules_par_s_par_noeud\": [" << parNoeud.str() << "]}";
+                rapport.flush();
+            }
+            premier = false;
+        }
+    }
+    if (format == "json") rapport << "\n]" << endl;
+    return echecAllocations ? 1 : 0;
+}
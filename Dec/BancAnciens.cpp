@@ -0,0 +1,67 @@
+// Les deux programmes d'origine sont inclus tels quels, chacun dans son espace de noms :
+// leurs classes Grille, Position, Regle... ne se mélangent ni entre elles ni avec celles de Dec/.
+// Les en-têtes qu'ils utilisent sont inclus avant, hors des espaces de noms.
+#include <SFML/Graphics.hpp>
+#include <omp.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <deque>
+#include <unordered_set>
+#include <vector>
+#include <unistd.h>
+#include "BancAnciens.h"
+#include "Empreinte.h"
+
+namespace evan {
+#define main principalEvan
+#include "../Projet_POO_Evan.cpp"
+#undef main
+}
+
+namespace multithreads {
+#define main principalMultiThreads
+#include "../Projet_POO_MultiThreads.cpp"
+#undef main
+}
+
+// Les grilles d'origine ne se chargent que depuis un fichier : la configuration passe par un fichier temporaire
+static std::string ecrireTemporaire(const GrilleBits& etat) {
+    std::string chemin = (std::filesystem::temp_directory_path() / ("banc_" + std::to_string(getpid()) + ".txt")).string();
+    std::ofstream fichier(chemin);
+    fichier << etat.getNbLignes() << " " << etat.getNbColonnes() << "\n";
+    for (int i = 0; i < etat.getNbLignes(); ++i) {
+        for (int j = 0; j < etat.getNbColonnes(); ++j) fichier << (etat.get(i, j) ? "1 " : "0 ");
+        fichier << "\n";
+    }
+    return chemin;
+}
+
+template <typename G>
+static Candidat adapter(const std::string& nom) {
+    auto grille = std::make_shared<std::unique_ptr<G>>();
+    Candidat candidat;
+    candidat.nom = nom;
+    candidat.charger = [grille](const GrilleBits& etat) {
+        std::string chemin = ecrireTemporaire(etat);
+        *grille = std::make_unique<G>(0, 0);
+        (*grille)->ficher(chemin);
+        std::filesystem::remove(chemin);
+    };
+    candidat.avancer = [grille](long long n) {
+        for (long long i = 0; i < n; ++i) (*grille)->updateGrille(); // La détection des répétitions fait partie du coût mesuré
+    };
+    return candidat;
+}
+
+std::vector<Candidat> programmesAnciens() {
+    return {adapter<evan::Grille>("evan"), adapter<multithreads::Grille>("multithreads")};
+}
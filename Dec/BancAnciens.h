@@ -0,0 +1,22 @@
+#ifndef BANCANCIENS_H
+#define BANCANCIENS_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include "GrilleBits.h"
+
+// Implémentation mesurée par le banc d'essai : chargement d'une configuration puis n générations
+struct Candidat {
+    std::string nom;
+    std::function<void(const GrilleBits&)> charger;
+    std::function<void(long long)> avancer;
+    std::function<long long()> octets; // Octets de grille lus et écrits depuis charger, estimés (absent : sans estimation)
+    std::function<void(std::vector<long long>&)> cellulesParNoeud; // Cellules calculées par nœud NUMA (absent ou vide : non mesuré)
+};
+
+// Versions d'origine en un seul fichier (Projet_POO_Evan.cpp et Projet_POO_MultiThreads.cpp).
+// Elles incluent SFML : disponibles seulement si le banc est compilé avec BANC_ANCIENS.
+std::vector<Candidat> programmesAnciens();
+
+#endif // BANCANCIENS_H
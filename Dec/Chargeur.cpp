@@ -0,0 +1,311 @@
+#include "Chargeur.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cctype>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+static const size_t TAILLE_MIN_MORCEAU = 1 << 20; // En dessous, découper le fichier coûte plus qu'il ne rapporte
+
+static inline bool estEspace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+static void fichierInvalide(const string& raison) {
+    cout << "Fichier de configuration invalide : " << raison << endl;
+    exit(1);
+}
+
+// Lit un entier positif ; faux si aucun chiffre
+static bool lireNombre(const char*& p, const char* fin, long long& valeur) {
+    while (p < fin && estEspace(*p)) ++p;
+    if (p == fin || !isdigit((unsigned char)*p)) return false;
+    valeur = 0;
+    while (p < fin && isdigit((unsigned char)*p)) {
+        valeur = valeur * 10 + (*p - '0');
+        if (valeur > (1LL << 40)) return false;
+        ++p;
+    }
+    return true;
+}
+
+// Fichier projeté en mémoire en lecture seule, libéré à la destruction
+struct FichierProjete {
+    int descripteur = -1;
+    const char* donnees = nullptr;
+    size_t taille = 0;
+
+    FichierProjete(const string& chemin) {
+        descripteur = open(chemin.c_str(), O_RDONLY);
+        struct stat infos;
+        if (descripteur < 0 || fstat(descripteur, &infos) != 0) {
+            cout << "Erreur : Impossible d'ouvrir le fichier !" << endl;
+            exit(1);
+        }
+        taille = (size_t)infos.st_size;
+        if (taille == 0) return;
+        void* adresse = mmap(nullptr, taille, PROT_READ, MAP_PRIVATE, descripteur, 0);
+        if (adresse == MAP_FAILED) {
+            cout << "Erreur : Impossible de projeter le fichier en memoire !" << endl;
+            exit(1);
+        }
+        madvise(adresse, taille, MADV_SEQUENTIAL);
+        donnees = (const char*)adresse;
+    }
+    ~FichierProjete() {
+        if (donnees) munmap((void*)donnees, taille);
+        if (descripteur >= 0) close(descripteur);
+    }
+};
+
+Chargeur::Chargeur(const char* debut, size_t taille, int lignesMin, int colonnesMin)
+    : debut(debut), fin(debut + taille), lignesMin(lignesMin), colonnesMin(colonnesMin) {}
+
+void Chargeur::chargerFichier(const string& chemin, GrilleBits& etat, int lignesMin, int colonnesMin, string* regle) {
+    FichierProjete fichier(chemin);
+    Chargeur chargeur(fichier.donnees, fichier.taille, lignesMin, colonnesMin);
+    chargeur.charger(etat, detecterFormat(chemin, fichier.donnees, fichier.taille));
+    if (regle) *regle = chargeur.getRegle();
+}
+
+const string& Chargeur::getRegle() const { return regleMotif; }
+
+RegleVie Chargeur::choisirRegle(const string& regleMotif, const RegleVie& regle, bool imposee) {
+    if (regleMotif.empty()) return regle;
+    RegleVie lue;
+    if (!RegleVie::lire(regleMotif, lue)) {
+        cerr << "Attention : regle du motif non prise en charge (" << regleMotif << "), " << regle.texte() << " est utilisee" << endl;
+        return regle;
+    }
+    if (!imposee) return lue;
+    if (lue != regle) {
+        cerr << "Attention : le motif est prevu pour " << lue.texte() << ", la regle " << regle.texte() << " de --regle est utilisee" << endl;
+    }
+    return regle;
+}
+
+FormatMotif Chargeur::detecterFormat(const string& chemin, const char* debut, size_t taille) {
+    string extension;
+    size_t point = chemin.find_last_of('.');
+    if (point != string::npos) extension = chemin.substr(point + 1);
+    transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)tolower(c); });
+    if (extension == "rle") return FormatMotif::RLE;
+    if (extension == "cells") return FormatMotif::Cells;
+
+    // Sinon, d'après le premier caractère significatif
+    for (size_t i = 0; i < taille; ++i) {
+        char c = debut[i];
+        if (estEspace(c)) continue;
+        if (c == '#' || c == 'x') return FormatMotif::RLE;
+        if (c == '!' || c == '.' || c == 'O') return FormatMotif::Cells;
+        break;
+    }
+    return FormatMotif::Matrice;
+}
+
+void Chargeur::charger(GrilleBits& etat, FormatMotif format) {
+    switch (format) {
+        case FormatMotif::RLE: chargerRLE(etat); break;
+        case FormatMotif::Cells: chargerCells(etat); break;
+        case FormatMotif::Matrice:
+        default: chargerMatrice(etat); break;
+    }
+}
+
+// Tore d'au moins lignesMin x colonnesMin cellules, motif centré
+void Chargeur::dimensionner(GrilleBits& etat, int lignesMotif, int colonnesMotif, int& decalageX, int& decalageY) const {
+    int lignes = max(lignesMotif, lignesMin), colonnes = max(colonnesMotif, colonnesMin);
+    if (lignes <= 0 || colonnes <= 0) fichierInvalide("motif vide");
+    etat.redimensionner(lignes, colonnes);
+    decalageX = (lignes - lignesMotif) / 2;
+    decalageY = (colonnes - colonnesMotif) / 2;
+}
+
+// Format historique. Le texte est découpé en morceaux (aux espaces) : un premier passage parallèle compte
+// les valeurs de chaque morceau, ce qui donne la première cellule de chacun, puis un second passage
+// parallèle remplit la grille. Les mots de 64 bits à cheval sur deux morceaux sont écrits par OU atomique.
+void Chargeur::chargerMatrice(GrilleBits& etat) {
+    const char* p = debut;
+    long long lignes = 0, colonnes = 0;
+    if (!lireNombre(p, fin, lignes) || !lireNombre(p, fin, colonnes) || lignes <= 0 || colonnes <= 0
+        || lignes > 1 << 30 || colonnes > 1 << 30) {
+        fichierInvalide("dimensions manquantes");
+    }
+    etat.redimensionner((int)lignes, (int)colonnes);
+    const long long nbCellules = lignes * colonnes;
+    const int motsParLigne = etat.getMotsParLigne();
+    uint64_t* mots = etat.ligne(0);
+
+    const size_t taille = fin - p;
+    int nbMorceaux = 1;
+#ifdef _OPENMP
+    nbMorceaux = max(1, min(omp_get_max_threads(), (int)(taille / TAILLE_MIN_MORCEAU)));
+#endif
+    vector<const char*> bornes(nbMorceaux + 1);
+    bornes[0] = p;
+    bornes[nbMorceaux] = fin;
+    for (int i = 1; i < nbMorceaux; ++i) {
+        const char* borne = max(bornes[i - 1], p + taille * i / nbMorceaux);
+        while (borne < fin && !estEspace(*borne)) ++borne; // Une valeur n'est jamais coupée en deux
+        bornes[i] = borne;
+    }
+
+    // Premier passage : nombre de valeurs par morceau
+    vector<long long> premieres(nbMorceaux + 1, 0);
+    #pragma omp parallel for schedule(static, 1) num_threads(nbMorceaux)
+    for (int m = 0; m < nbMorceaux; ++m) {
+        long long nombre = 0;
+        bool precedentEspace = true;
+        for (const char* c = bornes[m]; c < bornes[m + 1]; ++c) {
+            bool espace = estEspace(*c);
+            nombre += precedentEspace && !espace;
+            precedentEspace = espace;
+        }
+        premieres[m + 1] = nombre;
+    }
+    for (int m = 0; m < nbMorceaux; ++m) premieres[m + 1] += premieres[m];
+    if (premieres[nbMorceaux] < nbCellules) fichierInvalide("il manque des cellules");
+
+    // Second passage : chaque morceau écrit ses cellules à partir de sa première
+    bool invalide = false;
+    #pragma omp parallel for schedule(static, 1) num_threads(nbMorceaux) reduction(||:invalide)
+    for (int m = 0; m < nbMorceaux; ++m) {
+        long long cellule = premieres[m];
+        size_t indiceMot = (size_t)-1;
+        uint64_t mot = 0;
+        const char* c = bornes[m];
+        const char* finMorceau = bornes[m + 1];
+        while (c < finMorceau && cellule < nbCellules) {
+            if (estEspace(*c)) { ++c; continue; }
+            long long valeur = 0;
+            for (; c < finMorceau && !estEspace(*c); ++c) {
+                if (!isdigit((unsigned char)*c)) { invalide = true; valeur = -1; }
+                else if (valeur >= 0 && valeur < 10) valeur = valeur * 10 + (*c - '0');
+            }
+            if (valeur == 1) {
+                long long x = cellule / colonnes, y = cellule % colonnes;
+                size_t indice = (size_t)x * motsParLigne + (size_t)(y >> 6);
+                if (indice != indiceMot) {
+                    if (mot) __atomic_fetch_or(&mots[indiceMot], mot, __ATOMIC_RELAXED);
+                    indiceMot = indice;
+                    mot = 0;
+                }
+                mot |= 1ULL << (y & 63);
+            }
+            ++cellule;
+        }
+        if (mot) __atomic_fetch_or(&mots[indiceMot], mot, __ATOMIC_RELAXED);
+    }
+    if (invalide) fichierInvalide("valeur non numerique");
+}
+
+// Format RLE : en-tête "x = colonnes, y = lignes[, rule = ...]" puis le motif compressé
+void Chargeur::chargerRLE(GrilleBits& etat) {
+    const char* p = debut;
+    long long colonnesMotif = -1, lignesMotif = -1;
+
+    // Lignes de commentaires '#' puis ligne d'en-tête
+    while (p < fin) {
+        while (p < fin && estEspace(*p)) ++p;
+        if (p < fin && *p == '#') {
+            while (p < fin && *p != '\n') ++p;
+            continue;
+        }
+        break;
+    }
+    while (p < fin && *p != '\n') {
+        if (fin - p > 4 && string(p, 4) == "rule") { // rule = B3/S23[:T20,30], le suffixe de topologie de Golly est ignoré (tore)
+            const char* q = p + 4;
+            while (q < fin && (*q == ' ' || *q == '\t')) ++q;
+            if (q < fin && *q == '=') {
+                for (++q; q < fin && (*q == ' ' || *q == '\t'); ++q) {}
+                p = q;
+                while (p < fin && !estEspace(*p)) ++p;
+                regleMotif.assign(q, find(q, p, ':'));
+                if (!regleMotif.empty() && regleMotif.back() == ',') regleMotif.pop_back();
+                continue;
+            }
+        }
+        char cle = *p++;
+        if (cle != 'x' && cle != 'y') continue;
+        const char* q = p;
+        while (q < fin && (*q == ' ' || *q == '\t')) ++q;
+        if (q == fin || *q != '=') continue;
+        ++q;
+        long long valeur;
+        if (!lireNombre(q, fin, valeur)) fichierInvalide("en-tete RLE");
+        (cle == 'x' ? colonnesMotif : lignesMotif) = valeur;
+        p = q;
+    }
+    if (colonnesMotif < 0 || lignesMotif < 0 || colonnesMotif > 1 << 30 || lignesMotif > 1 << 30) {
+        fichierInvalide("en-tete RLE (x = ..., y = ...) manquant");
+    }
+
+    int dx = 0, dy = 0;
+    dimensionner(etat, (int)lignesMotif, (int)colonnesMotif, dx, dy);
+
+    long long x = 0, y = 0, nombre = 0;
+    for (; p < fin && *p != '!'; ++p) {
+        char c = *p;
+        if (isdigit((unsigned char)c)) {
+            nombre = nombre * 10 + (c - '0');
+            if (nombre > (1LL << 40)) fichierInvalide("repetition RLE trop grande");
+            continue;
+        }
+        if (estEspace(c)) continue;
+        long long n = nombre ? nombre : 1;
+        nombre = 0;
+        if (c == '$') {
+            x += n;
+            y = 0;
+        } else if (c == 'b' || c == '.') {
+            y += n;
+        } else if (isalpha((unsigned char)c)) { // 'o' (et les états des variantes à plusieurs états) : vivante
+            if (x >= lignesMotif || y + n > colonnesMotif) fichierInvalide("motif RLE plus grand que son en-tete");
+            for (long long k = 0; k < n; ++k) etat.set((int)x + dx, (int)(y + k) + dy, true);
+            y += n;
+        } else {
+            fichierInvalide(string("caractere RLE inattendu '") + c + "'");
+        }
+    }
+}
+
+// Format Cells : une ligne de texte par ligne de la grille, les lignes courtes sont complétées par des mortes
+void Chargeur::chargerCells(GrilleBits& etat) {
+    // Premier passage : dimensions du motif
+    long long lignesMotif = 0, colonnesMotif = 0;
+    for (const char* p = debut; p < fin;) {
+        const char* finLigne = find(p, fin, '\n');
+        if (*p != '!') {
+            const char* q = finLigne;
+            while (q > p && estEspace(q[-1])) --q;
+            colonnesMotif = max(colonnesMotif, (long long)(q - p));
+            ++lignesMotif;
+        }
+        p = finLigne + (finLigne < fin);
+    }
+    if (colonnesMotif == 0) lignesMotif = 0; // Fichier sans cellule
+    if (lignesMotif > 1 << 30 || colonnesMotif > 1 << 30) fichierInvalide("motif trop grand");
+
+    int dx = 0, dy = 0;
+    dimensionner(etat, (int)lignesMotif, (int)colonnesMotif, dx, dy);
+
+    int x = 0;
+    for (const char* p = debut; p < fin;) {
+        const char* finLigne = find(p, fin, '\n');
+        if (*p != '!') {
+            for (const char* c = p; c < finLigne; ++c) {
+                if (*c == 'O' || *c == '*') etat.set(x + dx, (int)(c - p) + dy, true);
+                else if (*c != '.' && !estEspace(*c)) fichierInvalide(string("caractere inattendu '") + *c + "'");
+            }
+            ++x;
+        }
+        p = finLigne + (finLigne < fin);
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef CHARGEUR_H
+#define CHARGEUR_H
+
+#include <string>
+#include <cstddef>
+#include "GrilleBits.h"
+#include "RegleVie.h"
+
+// Formats de fichier de configuration reconnus
+enum class FormatMotif { Matrice, RLE, Cells };
+
+// Chargement rapide d'une configuration initiale : le fichier est projeté en mémoire (mmap) et analysé
+// sans flux formatés, directement dans la grille compacte.
+//   - Matrice : "lignes colonnes" puis une valeur 0/1 par cellule (format historique), analysé en parallèle ;
+//   - RLE (.rle) : "x = C, y = L[, rule = R]" puis des suites <nombre><b|o|$> terminées par '!' ;
+//   - Cells (.cells) : commentaires '!' puis une ligne de '.' (morte) et 'O' (vivante) par ligne de la grille.
+// Pour RLE et Cells, le motif est centré dans un tore d'au moins lignesMin x colonnesMin cellules.
+class Chargeur {
+private:
+    const char* debut;
+    const char* fin;
+    int lignesMin, colonnesMin;
+    std::string regleMotif; // Champ rule de l'en-tête RLE (vide si absent)
+
+    void chargerMatrice(GrilleBits& etat);
+    void chargerRLE(GrilleBits& etat);
+    void chargerCells(GrilleBits& etat);
+    void dimensionner(GrilleBits& etat, int lignesMotif, int colonnesMotif, int& decalageX, int& decalageY) const;
+
+public:
+    Chargeur(const char* debut, std::size_t taille, int lignesMin = 0, int colonnesMin = 0);
+    void charger(GrilleBits& etat, FormatMotif format);
+    const std::string& getRegle() const;
+
+    static FormatMotif detecterFormat(const std::string& chemin, const char* debut, std::size_t taille);
+    static void chargerFichier(const std::string& chemin, GrilleBits& etat, int lignesMin = 0, int colonnesMin = 0,
+                               std::string* regle = nullptr); // regle : champ rule du motif RLE
+    // Règle de la simulation : celle du motif si la ligne de commande n'en impose pas, avertissement si elles diffèrent
+    static RegleVie choisirRegle(const std::string& regleMotif, const RegleVie& regle, bool imposee);
+};
+
+#endif // CHARGEUR_H
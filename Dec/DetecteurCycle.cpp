@@ -0,0 +1,321 @@
+#include "DetecteurCycle.h"
+#include <algorithm>
+#include "ArchiveRun.h"
+
+namespace {
+
+void effacer(BlocEmpreintes& bloc) { bloc.entrees.clear(); }
+void effacer(BlocChangements& bloc) {
+    bloc.cles.clear();
+    bloc.fins.clear();
+}
+
+// Bloc vide, recyclé si possible : aucune allocation une fois la fenêtre remplie
+template <typename Bloc>
+std::shared_ptr<Bloc> nouveauBloc(std::vector<std::shared_ptr<Bloc>>& recyclage) {
+    if (recyclage.empty()) return std::make_shared<Bloc>();
+    std::shared_ptr<Bloc> bloc = std::move(recyclage.back());
+    recyclage.pop_back();
+    return bloc;
+}
+
+// Un bloc partagé peut encore être lu par le thread d'écriture : il est libéré par son dernier détenteur
+template <typename Bloc>
+void liberer(std::shared_ptr<Bloc>& bloc, std::vector<std::shared_ptr<Bloc>>& recyclage) {
+    if (bloc->partage) return;
+    effacer(*bloc);
+    recyclage.push_back(std::move(bloc));
+}
+
+} // namespace
+
+DetecteurCycle::DetecteurCycle(std::size_t capacite, std::size_t budgetChangements)
+    : capacite(capacite), budgetChangements(budgetChangements), generation(0), periode(0), premiereEmpreinte(0),
+      nbEmpreintes(0), premiereListe(0), nbListes(0), totalChangements(0), verificationEnCours(false),
+      generationInstantane(0), periodeCandidate(0) {}
+
+void DetecteurCycle::vider() {
+    vues.clear();
+    for (std::shared_ptr<BlocEmpreintes>& bloc : ordre) liberer(bloc, recyclageEmpreintes);
+    ordre.clear();
+    for (std::shared_ptr<BlocChangements>& bloc : changements) liberer(bloc, recyclageChangements);
+    changements.clear();
+    premiereEmpreinte = nbEmpreintes = 0;
+    premiereListe = nbListes = 0;
+    totalChangements = 0;
+    verificationEnCours = false;
+}
+
+void DetecteurCycle::initialiser(const GrilleBits& etat, int generationInitiale) {
+    vider();
+    empreinte = Empreinte::calculer(etat);
+    generation = generationInitiale;
+    periode = 0;
+    memoriser(); // La configuration initiale fait partie de l'historique
+}
+
+// Ajoute l'empreinte courante à la fenêtre glissante
+void DetecteurCycle::memoriser() {
+    vues[empreinte] = generation;
+    if (ordre.empty() || ordre.back()->partage || ordre.back()->entrees.size() >= EMPREINTES_PAR_BLOC) {
+        ordre.push_back(nouveauBloc(recyclageEmpreintes));
+    }
+    ordre.back()->entrees.emplace_back(empreinte, generation);
+    ++nbEmpreintes;
+    if (nbEmpreintes > capacite) {
+        const auto& [ancienne, generationAncienne] = ordre.front()->entrees[premiereEmpreinte];
+        auto it = vues.find(ancienne);
+        if (it != vues.end() && it->second == generationAncienne) vues.erase(it); // Oublie la plus ancienne
+        --nbEmpreintes;
+        if (++premiereEmpreinte == ordre.front()->entrees.size()) {
+            liberer(ordre.front(), recyclageEmpreintes);
+            ordre.pop_front();
+            premiereEmpreinte = 0;
+        }
+    }
+}
+
+// Conserve les changements de cette génération dans la limite du budget
+void DetecteurCycle::ajouterChangements(const std::vector<uint64_t>& cles) {
+    BlocChangements* bloc = changements.empty() ? nullptr : changements.back().get();
+    if (!bloc || bloc->partage || (!bloc->cles.empty() && bloc->cles.size() + cles.size() > CLES_PAR_BLOC)) {
+        changements.push_back(nouveauBloc(recyclageChangements));
+        bloc = changements.back().get();
+    }
+    bloc->cles.insert(bloc->cles.end(), cles.begin(), cles.end());
+    bloc->fins.push_back((uint32_t)bloc->cles.size());
+    ++nbListes;
+    totalChangements += cles.size();
+    while (nbListes > 1 && (totalChangements > budgetChangements || nbListes > capacite)) {
+        BlocChangements& premier = *changements.front();
+        totalChangements -= premier.fins[premiereListe] - (premiereListe ? premier.fins[premiereListe - 1] : 0);
+        --nbListes;
+        if (++premiereListe == premier.fins.size()) {
+            liberer(changements.front(), recyclageChangements);
+            changements.pop_front();
+            premiereListe = 0;
+        }
+    }
+}
+
+// La génération courante est identique à celle d'il y a p générations si chaque cellule
+// a changé un nombre pair de fois pendant ces p générations
+bool DetecteurCycle::confirmerParChangements(int p) {
+    tampon.clear();
+    std::size_t restantes = (std::size_t)p;
+    for (auto it = changements.rbegin(); restantes > 0; ++it) {
+        const BlocChangements& bloc = **it;
+        const std::size_t vivantes = bloc.fins.size() - (it + 1 == changements.rend() ? premiereListe : 0);
+        const std::size_t prises = std::min(vivantes, restantes);
+        const std::size_t premiere = bloc.fins.size() - prises;
+        tampon.insert(tampon.end(), bloc.cles.begin() + (premiere ? bloc.fins[premiere - 1] : 0), bloc.cles.end());
+        restantes -= prises;
+    }
+    std::sort(tampon.begin(), tampon.end());
+    for (std::size_t i = 0; i < tampon.size(); ) {
+        std::size_t j = i;
+        while (j < tampon.size() && tampon[j] == tampon[i]) ++j;
+        if ((j - i) % 2 != 0) return false;
+        i = j;
+    }
+    return true;
+}
+
+bool DetecteurCycle::enregistrer(const std::vector<uint64_t>& cles, const Moteur& moteur) {
+    ++generation;
+    for (uint64_t cle : cles) empreinte.basculer(cle);
+    ajouterChangements(cles);
+
+    // Confirmation différée : l'instantané doit réapparaître exactement une période plus tard
+    if (verificationEnCours && generation == generationInstantane + periodeCandidate) {
+        verificationEnCours = false;
+        moteur.exporter(comparaison);
+        if (comparaison == instantane) {
+            periode = periodeCandidate;
+            return true;
+        }
+    }
+
+    auto it = vues.find(empreinte);
+    if (it != vues.end()) {
+        int p = generation - it->second;
+        if ((std::size_t)p <= nbListes) {
+            if (confirmerParChangements(p)) {
+                periode = p;
+                return true; // Configuration répétée : la grille est stabilisée
+            }
+        } else if (!verificationEnCours) {
+            moteur.exporter(instantane); // Période trop longue pour la fenêtre : vérification par instantané
+            generationInstantane = generation;
+            periodeCandidate = p;
+            verificationEnCours = true;
+        }
+    }
+
+    memoriser();
+    return false;
+}
+
+// Les blocs deviennent partagés : le thread de calcul n'y touche plus, seule la liste des blocs est copiée
+// (et l'instantané d'une vérification en cours)
+void DetecteurCycle::capturer(HistoriqueCycles& copie) {
+    copie.empreinte = empreinte;
+    copie.generation = generation;
+    copie.periode = periode;
+    for (const std::shared_ptr<BlocEmpreintes>& bloc : ordre) bloc->partage = true;
+    copie.empreintes.assign(ordre.begin(), ordre.end());
+    copie.premiereEmpreinte = premiereEmpreinte;
+    for (const std::shared_ptr<BlocChangements>& bloc : changements) bloc->partage = true;
+    copie.changements.assign(changements.begin(), changements.end());
+    copie.premiereListe = premiereListe;
+    copie.verificationEnCours = verificationEnCours;
+    copie.generationInstantane = generationInstantane;
+    copie.periodeCandidate = periodeCandidate;
+    if (verificationEnCours) copie.instantane = instantane;
+}
+
+// La table vues se déduit de l'ordre des empreintes
+bool DetecteurCycle::restaurer(const HistoriqueCycles& copie) {
+    vider();
+    empreinte = copie.empreinte;
+    generation = copie.generation;
+    periode = copie.periode;
+    ordre.assign(copie.empreintes.begin(), copie.empreintes.end());
+    premiereEmpreinte = copie.premiereEmpreinte;
+    if (ordre.empty() ? premiereEmpreinte != 0 : premiereEmpreinte >= ordre.front()->entrees.size()) return false;
+    for (std::size_t b = 0; b < ordre.size(); ++b) {
+        ordre[b]->partage = true;
+        for (std::size_t i = b ? 0 : premiereEmpreinte; i < ordre[b]->entrees.size(); ++i) {
+            vues[ordre[b]->entrees[i].first] = ordre[b]->entrees[i].second; // La plus récente l'emporte, comme dans memoriser
+            ++nbEmpreintes;
+        }
+    }
+    changements.assign(copie.changements.begin(), copie.changements.end());
+    premiereListe = copie.premiereListe;
+    if (changements.empty() ? premiereListe != 0 : premiereListe >= changements.front()->fins.size()) return false;
+    for (std::size_t b = 0; b < changements.size(); ++b) {
+        const BlocChangements& bloc = *changements[b];
+        changements[b]->partage = true;
+        const std::size_t premiere = b ? 0 : premiereListe;
+        if (bloc.fins.empty()) return false;
+        nbListes += bloc.fins.size() - premiere;
+        totalChangements += bloc.fins.back() - (premiere ? bloc.fins[premiere - 1] : 0);
+    }
+    verificationEnCours = copie.verificationEnCours;
+    generationInstantane = copie.generationInstantane;
+    periodeCandidate = copie.periodeCandidate;
+    if (verificationEnCours) instantane = copie.instantane;
+    return true;
+}
+
+// Empreintes avec les écarts de génération ; changements de chaque génération triés, en écarts :
+// (écart de colonne << 1) sur la même ligne, sinon (écart de ligne << 1 | 1) puis la colonne
+void HistoriqueCycles::serialiser(std::vector<uint8_t>& sortie) const {
+    ecrireFixe<uint64_t>(sortie, empreinte.a);
+    ecrireFixe<uint64_t>(sortie, empreinte.b);
+    ecrireFixe<int32_t>(sortie, generation);
+    ecrireFixe<int32_t>(sortie, periode);
+
+    std::size_t nombre = 0;
+    for (std::size_t b = 0; b < empreintes.size(); ++b) nombre += empreintes[b]->entrees.size() - (b ? 0 : premiereEmpreinte);
+    ecrireVarint(sortie, nombre);
+    uint32_t precedente = 0;
+    for (std::size_t b = 0; b < empreintes.size(); ++b) {
+        for (std::size_t i = b ? 0 : premiereEmpreinte; i < empreintes[b]->entrees.size(); ++i) {
+            const auto& [vue, generationVue] = empreintes[b]->entrees[i];
+            ecrireFixe<uint64_t>(sortie, vue.a);
+            ecrireFixe<uint64_t>(sortie, vue.b);
+            ecrireVarint(sortie, (uint32_t)generationVue - precedente);
+            precedente = (uint32_t)generationVue;
+        }
+    }
+
+    nombre = 0;
+    for (std::size_t b = 0; b < changements.size(); ++b) nombre += changements[b]->fins.size() - (b ? 0 : premiereListe);
+    ecrireVarint(sortie, nombre);
+    std::vector<uint64_t> triees;
+    for (std::size_t b = 0; b < changements.size(); ++b) {
+        const BlocChangements& bloc = *changements[b];
+        for (std::size_t l = b ? 0 : premiereListe; l < bloc.fins.size(); ++l) {
+            triees.assign(bloc.cles.begin() + (l ? bloc.fins[l - 1] : 0), bloc.cles.begin() + bloc.fins[l]);
+            std::sort(triees.begin(), triees.end()); // L'ordre d'une liste est sans effet sur la confirmation
+            ecrireVarint(sortie, triees.size());
+            uint32_t ligne = 0, colonne = 0;
+            for (uint64_t cle : triees) {
+                const uint32_t l2 = (uint32_t)(cle >> 32), c2 = (uint32_t)cle;
+                if (l2 == ligne) {
+                    ecrireVarint(sortie, (uint64_t)(c2 - colonne) << 1);
+                } else {
+                    ecrireVarint(sortie, (uint64_t)(l2 - ligne) << 1 | 1);
+                    ecrireVarint(sortie, c2);
+                }
+                ligne = l2;
+                colonne = c2;
+            }
+        }
+    }
+
+    sortie.push_back(verificationEnCours);
+    if (verificationEnCours) {
+        ecrireFixe<int32_t>(sortie, generationInstantane);
+        ecrireFixe<int32_t>(sortie, periodeCandidate);
+        instantane.serialiser(sortie);
+    }
+}
+
+// Historique relu dans un seul bloc d'empreintes et un seul bloc de changements
+bool HistoriqueCycles::restaurer(const uint8_t*& debut, const uint8_t* fin) {
+    empreintes.clear();
+    changements.clear();
+    premiereEmpreinte = premiereListe = 0;
+    uint64_t nombre;
+    if (!lireFixe(debut, fin, empreinte.a) || !lireFixe(debut, fin, empreinte.b) || !lireFixe(debut, fin, generation)
+        || !lireFixe(debut, fin, periode) || !lireVarint(debut, fin, nombre) || nombre > (uint64_t)(fin - debut) / 17) return false;
+    auto blocEmpreintes = std::make_shared<BlocEmpreintes>();
+    blocEmpreintes->entrees.reserve(nombre);
+    uint32_t precedente = 0;
+    for (uint64_t i = 0; i < nombre; ++i) {
+        Empreinte vue;
+        uint64_t ecart;
+        if (!lireFixe(debut, fin, vue.a) || !lireFixe(debut, fin, vue.b) || !lireVarint(debut, fin, ecart)) return false;
+        precedente += (uint32_t)ecart;
+        blocEmpreintes->entrees.emplace_back(vue, (int)precedente);
+    }
+    if (nombre > 0) empreintes.push_back(std::move(blocEmpreintes));
+
+    if (!lireVarint(debut, fin, nombre) || nombre > (uint64_t)(fin - debut)) return false;
+    auto blocChangements = std::make_shared<BlocChangements>();
+    blocChangements->fins.reserve(nombre);
+    for (uint64_t i = 0; i < nombre; ++i) {
+        uint64_t taille;
+        if (!lireVarint(debut, fin, taille) || taille > (uint64_t)(fin - debut)
+            || blocChangements->cles.size() + taille > UINT32_MAX) return false;
+        uint32_t ligne = 0, colonne = 0;
+        for (uint64_t k = 0; k < taille; ++k) {
+            uint64_t code, valeur;
+            if (!lireVarint(debut, fin, code)) return false;
+            if (code & 1) {
+                if (!lireVarint(debut, fin, valeur)) return false;
+                ligne += (uint32_t)(code >> 1);
+                colonne = (uint32_t)valeur;
+            } else {
+                colonne += (uint32_t)(code >> 1);
+            }
+            blocChangements->cles.push_back((uint64_t)ligne << 32 | colonne);
+        }
+        blocChangements->fins.push_back((uint32_t)blocChangements->cles.size());
+    }
+    if (nombre > 0) changements.push_back(std::move(blocChangements));
+
+    if (debut >= fin) return false;
+    verificationEnCours = *debut++ != 0;
+    if (verificationEnCours) {
+        if (!lireFixe(debut, fin, generationInstantane) || !lireFixe(debut, fin, periodeCandidate)
+            || !instantane.restaurer(debut, fin)) return false;
+    }
+    return true;
+}
+
+int DetecteurCycle::getPeriode() const { return periode; }
+int DetecteurCycle::getGeneration() const { return generation; }
+const Empreinte& DetecteurCycle::getEmpreinte() const { return empreinte; }
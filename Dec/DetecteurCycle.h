@@ -0,0 +1,90 @@
+#ifndef DETECTEURCYCLE_H
+#define DETECTEURCYCLE_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+#include "Empreinte.h"
+#include "GrilleBits.h"
+#include "Moteur.h"
+
+// Blocs de l'historique. Un bloc capturé par un point de reprise est partagé avec le thread d'écriture :
+// il n'est plus jamais modifié, les ajouts suivants commencent un nouveau bloc.
+struct BlocEmpreintes {
+    std::vector<std::pair<Empreinte, int>> entrees; // Empreinte et génération, dans l'ordre des générations
+    bool partage = false;
+};
+struct BlocChangements {
+    std::vector<uint64_t> cles;  // Listes de plusieurs générations mises bout à bout
+    std::vector<uint32_t> fins;  // Fin de la liste de chaque génération dans cles
+    bool partage = false;
+};
+
+// Historique capturé pour un point de reprise : les blocs sont partagés, pas copiés. L'encodage (varints,
+// clés triées en écarts) se fait sur le thread d'écriture.
+struct HistoriqueCycles {
+    Empreinte empreinte;
+    int generation = 0, periode = 0;
+    std::vector<std::shared_ptr<BlocEmpreintes>> empreintes;
+    std::size_t premiereEmpreinte = 0;  // Entrées du premier bloc déjà sorties de la fenêtre
+    std::vector<std::shared_ptr<BlocChangements>> changements;
+    std::size_t premiereListe = 0;      // Listes du premier bloc déjà sorties du budget
+    bool verificationEnCours = false;
+    int generationInstantane = 0, periodeCandidate = 0;
+    GrilleBits instantane;
+
+    void serialiser(std::vector<uint8_t>& sortie) const;
+    bool restaurer(const uint8_t*& debut, const uint8_t* fin); // Faux si les données sont invalides
+};
+
+// Détection des configurations répétées avec une mémoire bornée.
+// Chaque génération est résumée par une empreinte de Zobrist mise à jour à partir des cellules qui ont changé.
+// Une empreinte déjà vue n'est qu'un candidat : la répétition est confirmée exactement, soit par les
+// changements conservés (chaque cellule doit avoir basculé un nombre pair de fois), soit par un
+// instantané complet comparé une période plus tard.
+class DetecteurCycle {
+private:
+    static constexpr std::size_t EMPREINTES_PAR_BLOC = 1 << 12;
+    static constexpr std::size_t CLES_PAR_BLOC = 1 << 16;
+
+    std::size_t capacite;          // Nombre maximal d'empreintes conservées (fenêtre glissante)
+    std::size_t budgetChangements; // Nombre maximal de changements de cellules conservés
+    Empreinte empreinte;           // Empreinte de la génération courante
+    int generation;
+    int periode;                   // Période du dernier cycle confirmé
+
+    std::unordered_map<Empreinte, int, HachageEmpreinte> vues; // Empreinte -> dernière génération où elle a été vue
+    std::deque<std::shared_ptr<BlocEmpreintes>> ordre;         // Empreintes dans l'ordre des générations
+    std::size_t premiereEmpreinte, nbEmpreintes;
+    std::deque<std::shared_ptr<BlocChangements>> changements;  // Cellules changées lors des dernières générations
+    std::size_t premiereListe, nbListes;
+    std::size_t totalChangements;
+    std::vector<std::shared_ptr<BlocEmpreintes>> recyclageEmpreintes; // Blocs libérés jamais partagés, réutilisés
+    std::vector<std::shared_ptr<BlocChangements>> recyclageChangements;
+    std::vector<uint64_t> tampon;
+
+    // Vérification différée d'une période plus longue que la fenêtre de changements
+    bool verificationEnCours;
+    int generationInstantane, periodeCandidate;
+    GrilleBits instantane, comparaison;
+
+    bool confirmerParChangements(int p);
+    void memoriser();
+    void ajouterChangements(const std::vector<uint64_t>& cles);
+    void vider();
+
+public:
+    DetecteurCycle(std::size_t capacite = 1 << 20, std::size_t budgetChangements = 1 << 24);
+    void initialiser(const GrilleBits& etat, int generationInitiale = 0);
+    bool enregistrer(const std::vector<uint64_t>& cles, const Moteur& moteur); // Vrai si un cycle est confirmé
+    void capturer(HistoriqueCycles& copie);          // Historique complet sans copie des blocs (points de reprise)
+    bool restaurer(const HistoriqueCycles& copie);   // Faux si l'historique est incohérent
+    int getPeriode() const;
+    int getGeneration() const;
+    const Empreinte& getEmpreinte() const;
+};
+
+#endif // DETECTEURCYCLE_H
@@ -0,0 +1,135 @@
+#include "DomaineMpi.h"
+#include "RechercheSoupes.h"
+#include <cstring>
+#include <utility>
+
+namespace {
+const int ETIQUETTE_PREMIERE = 0; // Première ligne de la bande, envoyée au rang du dessus
+const int ETIQUETTE_DERNIERE = 1; // Dernière ligne de la bande, envoyée au rang du dessous
+} // namespace
+
+DomaineMpi::DomaineMpi(MPI_Comm comm, int nbLignes, int nbColonnes, const RegleVie& regle)
+    : comm(comm), nbLignes(nbLignes), nbColonnes(nbColonnes), noyau(choisirNoyau(regle)), regle(regle),
+      secondesCalcul(0), secondesAttente(0) {
+    MPI_Comm_rank(comm, &rang);
+    MPI_Comm_size(comm, &nbRangs);
+    debut = (int)((long long)nbLignes * rang / nbRangs);
+    nbLocales = (int)((long long)nbLignes * (rang + 1) / nbRangs) - debut;
+    bloc.redimensionner(nbLocales + 2, nbColonnes);
+    suivant.redimensionner(nbLocales + 2, nbColonnes);
+}
+
+// Le rang 0 a lu la grille complète : chaque autre rang ne reçoit que sa bande (comme rassembler, en sens inverse)
+void DomaineMpi::charger(const GrilleBits& complet) {
+    const int mots = bloc.getMotsParLigne();
+    std::vector<int> nombres(nbRangs), deplacements(nbRangs);
+    for (int r = 0; r < nbRangs; ++r) {
+        int premiere = (int)((long long)nbLignes * r / nbRangs);
+        nombres[r] = ((int)((long long)nbLignes * (r + 1) / nbRangs) - premiere) * mots;
+        deplacements[r] = premiere * mots;
+    }
+    MPI_Scatterv(rang == 0 ? complet.ligne(0) : nullptr, nombres.data(), deplacements.data(), MPI_UINT64_T,
+                 bloc.ligne(1), nbLocales * mots, MPI_UINT64_T, 0, comm);
+    calculerEmpreinte();
+}
+
+void DomaineMpi::remplirAleatoire(double densite, uint64_t graine) {
+    for (int x = 1; x <= nbLocales; ++x) {
+        RechercheSoupes::remplirLigne(bloc.ligne(x), nbColonnes, densite, graine, debut + x - 1);
+    }
+    calculerEmpreinte();
+}
+
+void DomaineMpi::calculerEmpreinte() {
+    empreinteLocale = Empreinte();
+    for (int x = 1; x <= nbLocales; ++x) {
+        for (int k = 0; k < bloc.getMotsParLigne(); ++k) {
+            for (uint64_t mot = bloc.ligne(x)[k]; mot; mot &= mot - 1) {
+                empreinteLocale.basculer(cleCellule(debut + x - 1, 64 * k + __builtin_ctzll(mot)));
+            }
+        }
+    }
+}
+
+void DomaineMpi::calculerLigne(int x) {
+    const int mots = bloc.getMotsParLigne();
+    noyau(bloc.ligne(x - 1), bloc.ligne(x), bloc.ligne(x + 1), suivant.ligne(x), nbColonnes, mots, 0, mots, regle);
+}
+
+void DomaineMpi::etape() {
+    const int mots = bloc.getMotsParLigne();
+    const int haut = (rang - 1 + nbRangs) % nbRangs, bas = (rang + 1) % nbRangs;
+
+    // Halos : réception dans les lignes 0 et nbLocales + 1, envoi des lignes de bord de la bande
+    MPI_Request requetes[4];
+    MPI_Irecv(bloc.ligne(0), mots, MPI_UINT64_T, haut, ETIQUETTE_DERNIERE, comm, &requetes[0]);
+    MPI_Irecv(bloc.ligne(nbLocales + 1), mots, MPI_UINT64_T, bas, ETIQUETTE_PREMIERE, comm, &requetes[1]);
+    MPI_Isend(bloc.ligne(1), mots, MPI_UINT64_T, haut, ETIQUETTE_PREMIERE, comm, &requetes[2]);
+    MPI_Isend(bloc.ligne(nbLocales), mots, MPI_UINT64_T, bas, ETIQUETTE_DERNIERE, comm, &requetes[3]);
+
+    // Intérieur de la bande pendant l'échange : ses voisines sont toutes locales
+    double t0 = MPI_Wtime();
+    for (int x = 2; x < nbLocales; ++x) calculerLigne(x);
+    double t1 = MPI_Wtime();
+    MPI_Waitall(4, requetes, MPI_STATUSES_IGNORE);
+    double t2 = MPI_Wtime();
+    calculerLigne(1);
+    if (nbLocales > 1) calculerLigne(nbLocales);
+
+    // Empreinte mise à jour à partir des cellules qui ont changé
+    for (int x = 1; x <= nbLocales; ++x) {
+        const uint64_t* a = bloc.ligne(x);
+        const uint64_t* b = suivant.ligne(x);
+        for (int k = 0; k < mots; ++k) {
+            for (uint64_t diff = a[k] ^ b[k]; diff; diff &= diff - 1) {
+                empreinteLocale.basculer(cleCellule(debut + x - 1, 64 * k + __builtin_ctzll(diff)));
+            }
+        }
+    }
+    std::swap(bloc, suivant);
+    secondesCalcul += (t1 - t0) + (MPI_Wtime() - t2);
+    secondesAttente += t2 - t1;
+}
+
+// Le OU exclusif des empreintes des bandes est l'empreinte de la grille complète
+Empreinte DomaineMpi::empreinte() const {
+    uint64_t locale[2] = {empreinteLocale.a, empreinteLocale.b}, globale[2];
+    MPI_Allreduce(locale, globale, 2, MPI_UINT64_T, MPI_BXOR, comm);
+    Empreinte e;
+    e.a = globale[0];
+    e.b = globale[1];
+    return e;
+}
+
+long long DomaineMpi::population() const {
+    long long locale = 0, globale = 0;
+    for (int x = 1; x <= nbLocales; ++x) {
+        for (int k = 0; k < bloc.getMotsParLigne(); ++k) locale += __builtin_popcountll(bloc.ligne(x)[k]);
+    }
+    MPI_Allreduce(&locale, &globale, 1, MPI_LONG_LONG, MPI_SUM, comm);
+    return globale;
+}
+
+void DomaineMpi::memoriser(GrilleBits& instantane) const { instantane = bloc; }
+
+bool DomaineMpi::identique(const GrilleBits& instantane) const {
+    int locale = 1, globale = 0;
+    for (int x = 1; x <= nbLocales && locale; ++x) {
+        locale = memcmp(instantane.ligne(x), bloc.ligne(x), sizeof(uint64_t) * bloc.getMotsParLigne()) == 0;
+    }
+    MPI_Allreduce(&locale, &globale, 1, MPI_INT, MPI_LAND, comm);
+    return globale != 0;
+}
+
+void DomaineMpi::rassembler(GrilleBits& complet) const {
+    const int mots = bloc.getMotsParLigne();
+    std::vector<int> nombres(nbRangs), deplacements(nbRangs);
+    for (int r = 0; r < nbRangs; ++r) {
+        int premiere = (int)((long long)nbLignes * r / nbRangs);
+        nombres[r] = ((int)((long long)nbLignes * (r + 1) / nbRangs) - premiere) * mots;
+        deplacements[r] = premiere * mots;
+    }
+    if (rang == 0) complet.redimensionner(nbLignes, nbColonnes);
+    MPI_Gatherv(bloc.ligne(1), nbLocales * mots, MPI_UINT64_T, rang == 0 ? complet.ligne(0) : nullptr,
+                nombres.data(), deplacements.data(), MPI_UINT64_T, 0, comm);
+}
@@ -0,0 +1,48 @@
+#ifndef DOMAINEMPI_H
+#define DOMAINEMPI_H
+
+#include <mpi.h>
+#include <vector>
+#include <cstdint>
+#include "GrilleBits.h"
+#include "NoyauDense.h"
+#include "Empreinte.h"
+#include "RegleVie.h"
+
+// Tore découpé en bandes de lignes entre les rangs MPI. Chaque rang possède une bande entourée de deux
+// lignes de halo (copies de la dernière ligne du rang du dessus et de la première ligne du rang du dessous),
+// échangées à chaque génération pendant le calcul de l'intérieur de la bande. Les colonnes ne sont pas
+// découpées : le tore horizontal est traité par le noyau, comme dans le moteur dense.
+class DomaineMpi {
+private:
+    MPI_Comm comm;
+    int rang, nbRangs;
+    int nbLignes, nbColonnes;   // Tore complet
+    int debut, nbLocales;       // Lignes globales [debut, debut + nbLocales) possédées par ce rang
+    GrilleBits bloc, suivant;   // Ligne 0 et ligne nbLocales + 1 : halos
+    NoyauLigne noyau;
+    RegleVie regle;
+    Empreinte empreinteLocale;  // Cellules vivantes de la bande, en coordonnées globales
+    double secondesCalcul, secondesAttente;
+
+    void calculerLigne(int x); // Ligne locale x (1 à nbLocales)
+    void calculerEmpreinte();  // Empreinte locale depuis les lignes de la bande
+
+public:
+    DomaineMpi(MPI_Comm comm, int nbLignes, int nbColonnes, const RegleVie& regle = RegleVie());
+    void charger(const GrilleBits& complet);                             // Bandes envoyées par le rang 0, seul à lire complet
+    void remplirAleatoire(double densite, uint64_t graine);             // Soupe de RechercheSoupes, lignes de la bande seules
+    void etape();                                                       // Échange des halos recouvert par le calcul
+    Empreinte empreinte() const;                                        // Empreinte globale (réduction collective)
+    long long population() const;                                       // Population globale (réduction collective)
+    void memoriser(GrilleBits& instantane) const;                       // Copie de la bande
+    bool identique(const GrilleBits& instantane) const;                 // Vrai sur tous les rangs si toutes les bandes sont identiques
+    void rassembler(GrilleBits& complet) const;                         // Grille complète sur le rang 0 (petites grilles)
+
+    int getRang() const { return rang; }
+    int getNbRangs() const { return nbRangs; }
+    double getSecondesCalcul() const { return secondesCalcul; }
+    double getSecondesAttente() const { return secondesAttente; }
+};
+
+#endif // DOMAINEMPI_H
@@ -0,0 +1,134 @@
+#include "EcrivainAsynchrone.h"
+#include "Grille.h"
+#include "Instrumentation.h"
+#include <iostream>
+
+EcrivainAsynchrone::EcrivainAsynchrone()
+    : format(FormatSortie::Archive), capacite(0), politique(PolitiqueFile::Bloquer), enCours(0), abandonnees(0), arret(false) {}
+
+EcrivainAsynchrone::~EcrivainAsynchrone() { arreter(); }
+
+void EcrivainAsynchrone::demarrer(FormatSortie formatSortie, const std::string& dossierSortie, int nbLignes, int nbColonnes,
+                                  int intervalleCles, std::size_t capaciteFile, PolitiqueFile politiqueFile,
+                                  const EtatArchive* reprise) {
+    arreter();
+    format = formatSortie;
+    dossier = dossierSortie;
+    capacite = capaciteFile;
+    politique = politiqueFile;
+    abandonnees = 0;
+    arret = false;
+    if (format == FormatSortie::Archive) {
+        if (reprise) archive.reprendre(dossier + "/simulation.jdv", *reprise, nbLignes, nbColonnes, intervalleCles);
+        else archive.ouvrir(dossier + "/simulation.jdv", nbLignes, nbColonnes, intervalleCles);
+    }
+    if (capacite > 0) fil = std::thread(&EcrivainAsynchrone::boucle, this);
+}
+
+void EcrivainAsynchrone::ecrire(long long generation, Type type, const GrilleBits& etat) {
+    MESURER_PHASE(Phase::Ecriture); // Sur le thread d'écriture : se recouvre avec les autres phases
+    if (type == Type::Stabilisation) Grille::ecrireStabilisation(etat, generation, dossier);
+    if (format == FormatSortie::Archive) archive.ajouter(generation, etat);
+    else if (format == FormatSortie::Texte && type == Type::Iteration) Grille::ecrireIteration(etat, generation, dossier);
+}
+
+void EcrivainAsynchrone::ecrireReprise(PointReprise& point) {
+    MESURER_PHASE(Phase::Ecriture);
+    point.avecArchive = archive.estOuverte();
+    archive.capturer(point.archive); // Toutes les générations précédentes sont déjà dans l'archive
+    if (!point.ecrire(dossier)) std::cerr << "Attention : point de reprise " << point.generation << " non ecrit" << std::endl;
+}
+
+void EcrivainAsynchrone::soumettreReprise(std::unique_ptr<PointReprise> point) {
+    if (!fil.joinable()) {
+        ecrireReprise(*point);
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> verrouillage(verrou);
+        place.wait(verrouillage, [this] { return file.size() + enCours < capacite; });
+        long long generation = point->generation;
+        file.push_back({generation, Type::Reprise, GrilleBits(), std::move(point)});
+    }
+    nonVide.notify_one();
+}
+
+void EcrivainAsynchrone::soumettre(long long generation, const GrilleBits& etat, Type type) {
+    if (!fil.joinable()) { // Écriture synchrone
+        ecrire(generation, type, etat);
+        return;
+    }
+
+    GrilleBits copie;
+    {
+        std::unique_lock<std::mutex> verrouillage(verrou);
+        if (file.size() + enCours >= capacite) {
+            if (politique == PolitiqueFile::Abandonner && type == Type::Iteration) {
+                ++abandonnees;
+                return;
+            }
+            place.wait(verrouillage, [this] { return file.size() + enCours < capacite; });
+        }
+        if (!libres.empty()) {
+            copie = std::move(libres.back());
+            libres.pop_back();
+        }
+    }
+    copie = etat; // Hors du verrou ; le tampon recyclé a déjà la bonne taille
+
+    {
+        std::lock_guard<std::mutex> verrouillage(verrou);
+        file.push_back({generation, type, std::move(copie), nullptr});
+    }
+    nonVide.notify_one();
+}
+
+void EcrivainAsynchrone::boucle() {
+    std::deque<Instantane> lot;
+    std::unique_lock<std::mutex> verrouillage(verrou);
+    while (true) {
+        nonVide.wait(verrouillage, [this] { return arret || !file.empty(); });
+        if (file.empty()) break; // Arrêt demandé et plus rien à écrire
+
+        lot.swap(file); // Toutes les générations en attente forment un lot
+        enCours = lot.size();
+        verrouillage.unlock();
+
+        for (Instantane& instantane : lot) {
+            if (instantane.reprise) ecrireReprise(*instantane.reprise);
+            else ecrire(instantane.generation, instantane.type, instantane.etat);
+        }
+        archive.vider(); // Un seul vidage par lot
+
+        verrouillage.lock();
+        for (Instantane& instantane : lot) {
+            if (!instantane.reprise) libres.push_back(std::move(instantane.etat));
+        }
+        lot.clear();
+        enCours = 0;
+        place.notify_all();
+        inactif.notify_all();
+    }
+}
+
+void EcrivainAsynchrone::vider() {
+    if (fil.joinable()) {
+        std::unique_lock<std::mutex> verrouillage(verrou);
+        inactif.wait(verrouillage, [this] { return file.empty() && enCours == 0; });
+    }
+    archive.vider();
+}
+
+void EcrivainAsynchrone::arreter() {
+    if (fil.joinable()) {
+        {
+            std::lock_guard<std::mutex> verrouillage(verrou);
+            arret = true;
+        }
+        nonVide.notify_one();
+        fil.join();
+    }
+    archive.fermer();
+}
+
+long long EcrivainAsynchrone::getAbandonnees() const { return abandonnees; }
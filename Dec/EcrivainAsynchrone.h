@@ -0,0 +1,68 @@
+#ifndef ECRIVAINASYNCHRONE_H
+#define ECRIVAINASYNCHRONE_H
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "GrilleBits.h"
+#include "ArchiveRun.h"
+#include "Parametres.h"
+#include "PointReprise.h"
+
+// Écriture des itérations sauvegardées sur un thread dédié.
+// La simulation dépose une copie compacte de la génération dans une file bornée et continue aussitôt ;
+// le thread d'écriture prend toutes les générations en attente d'un coup et les écrit en un lot
+// (archive ou fichiers texte), avec un seul vidage du tampon de l'archive par lot.
+// File pleine : la simulation attend (Bloquer) ou l'itération n'est pas sauvegardée (Abandonner).
+// Un état stabilisé n'est jamais abandonné.
+// Un point de reprise passe par la même file : quand il est écrit, l'archive contient exactement les
+// générations qui le précèdent, et son état d'écriture y est joint.
+class EcrivainAsynchrone {
+public:
+    enum class Type { Iteration, Stabilisation, Reprise };
+
+private:
+    struct Instantane {
+        long long generation;
+        Type type;
+        GrilleBits etat;
+        std::unique_ptr<PointReprise> reprise; // Type::Reprise uniquement
+    };
+
+    FormatSortie format;
+    std::string dossier;
+    ArchiveRun archive;           // Utilisée uniquement par le thread d'écriture une fois démarré
+    std::size_t capacite;         // Générations en attente ou en cours d'écriture (0 = écriture synchrone)
+    PolitiqueFile politique;
+
+    std::deque<Instantane> file;
+    std::vector<GrilleBits> libres; // Tampons déjà écrits, réutilisés sans allocation
+    std::size_t enCours;            // Générations du lot en cours d'écriture
+    std::atomic<long long> abandonnees; // Écrit sous verrou, lu sans verrou par getAbandonnees
+    bool arret;
+    std::mutex verrou;
+    std::condition_variable nonVide, place, inactif;
+    std::thread fil;
+
+    void boucle();
+    void ecrire(long long generation, Type type, const GrilleBits& etat);
+    void ecrireReprise(PointReprise& point);
+
+public:
+    EcrivainAsynchrone();
+    ~EcrivainAsynchrone();
+    void demarrer(FormatSortie format, const std::string& dossier, int nbLignes, int nbColonnes, int intervalleCles,
+                  std::size_t capacite, PolitiqueFile politique, const EtatArchive* reprise = nullptr); // reprise : archive continuée
+    void soumettre(long long generation, const GrilleBits& etat, Type type = Type::Iteration);
+    void soumettreReprise(std::unique_ptr<PointReprise> point); // Jamais abandonné ; le point est déjà une copie
+    void vider();   // Attend que toutes les générations déposées soient écrites
+    void arreter(); // Vide la file, arrête le thread et ferme l'archive
+    long long getAbandonnees() const;
+};
+
+#endif // ECRIVAINASYNCHRONE_H
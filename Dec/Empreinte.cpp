@@ -0,0 +1,31 @@
+#include "Empreinte.h"
+
+namespace {
+
+// Mélangeur splitmix64 : transforme une clé de cellule en 64 bits pseudo-aléatoires (aucune table à stocker)
+inline uint64_t melanger(uint64_t z) {
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+void Empreinte::basculer(uint64_t cle) {
+    a ^= melanger(cle);
+    b ^= melanger(cle ^ 0xd1b54a32d192ed03ULL);
+}
+
+Empreinte Empreinte::calculer(const GrilleBits& etat) {
+    Empreinte e;
+    for (int i = 0; i < etat.getNbLignes(); ++i) {
+        const uint64_t* ligne = etat.ligne(i);
+        for (int k = 0; k < etat.getMotsParLigne(); ++k) {
+            for (uint64_t mot = ligne[k]; mot; mot &= mot - 1) { // Parcourt les bits à 1
+                e.basculer(cleCellule(i, 64 * k + __builtin_ctzll(mot)));
+            }
+        }
+    }
+    return e;
+}
@@ -0,0 +1,31 @@
+#ifndef EMPREINTE_H
+#define EMPREINTE_H
+
+#include <cstdint>
+#include <cstddef>
+#include "GrilleBits.h"
+
+// Clé 64 bits d'une cellule (ligne dans les 32 bits de poids fort, colonne dans les 32 bits de poids faible)
+inline uint64_t cleCellule(int x, int y) {
+    return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+}
+inline int ligneCle(uint64_t cle) { return (int)(int32_t)(cle >> 32); }
+inline int colonneCle(uint64_t cle) { return (int)(int32_t)(uint32_t)cle; }
+
+// Empreinte de Zobrist sur 128 bits : OU exclusif des clés aléatoires des cellules vivantes.
+// Elle se met à jour en O(1) à chaque cellule qui change d'état.
+struct Empreinte {
+    uint64_t a = 0, b = 0;
+
+    void basculer(uint64_t cle);                    // Ajoute ou retire une cellule
+    static Empreinte calculer(const GrilleBits& etat); // Calcul complet depuis une grille
+
+    bool operator==(const Empreinte& other) const { return a == other.a && b == other.b; }
+    bool operator!=(const Empreinte& other) const { return !(*this == other); }
+};
+
+struct HachageEmpreinte {
+    std::size_t operator()(const Empreinte& e) const { return (std::size_t)e.a; }
+};
+
+#endif // EMPREINTE_H
@@ -0,0 +1,150 @@
+#include "FluxStatistiques.h"
+#include "ArchiveRun.h"
+#include "Instrumentation.h"
+#include <iostream>
+#include <filesystem>
+
+using namespace std;
+
+static const size_t TAILLE_ENTETE_STATISTIQUES = 8; // Magic, version
+static const size_t TAILLE_BLOC = 1 << 16;          // Écriture par blocs de 64 Ko
+
+static uint64_t zigzag(long long valeur) { return ((uint64_t)valeur << 1) ^ (uint64_t)(valeur >> 63); }
+static long long dezigzag(uint64_t valeur) { return (long long)(valeur >> 1) ^ -(long long)(valeur & 1); }
+
+FluxStatistiques::FluxStatistiques() : generationPrecedente(0) {}
+
+FluxStatistiques::~FluxStatistiques() { fermer(); }
+
+bool FluxStatistiques::estOuvert() const { return fichier.is_open(); }
+
+void FluxStatistiques::ouvrir(const string& chemin) {
+    fermer();
+    fichier.open(chemin, ios::binary | ios::trunc);
+    if (!fichier.is_open()) {
+        cerr << "Erreur : Impossible de creer " << chemin << endl;
+        exit(1);
+    }
+    generationPrecedente = 0;
+    precedentes = StatistiquesGeneration();
+    tampon.clear();
+    for (char c : MAGIC_STATISTIQUES) tampon.push_back((uint8_t)c);
+    ecrireFixe<uint32_t>(tampon, VERSION_STATISTIQUES);
+}
+
+void FluxStatistiques::ajouter(long long generation, const StatistiquesGeneration& stats) {
+    if (!fichier.is_open()) return;
+    ecrireVarint(tampon, (uint64_t)(generation - generationPrecedente));
+    ecrireVarint(tampon, zigzag(stats.population - precedentes.population));
+    ecrireVarint(tampon, (uint64_t)stats.naissances);
+    ecrireVarint(tampon, (uint64_t)stats.morts);
+    ecrireVarint(tampon, (uint64_t)(stats.tuilesModifiees + 1));
+    ecrireVarint(tampon, zigzag((long long)stats.ligneMin - precedentes.ligneMin));
+    ecrireVarint(tampon, zigzag((long long)stats.ligneMax - precedentes.ligneMax));
+    ecrireVarint(tampon, zigzag((long long)stats.colonneMin - precedentes.colonneMin));
+    ecrireVarint(tampon, zigzag((long long)stats.colonneMax - precedentes.colonneMax));
+    generationPrecedente = generation;
+    precedentes = stats;
+    if (tampon.size() >= TAILLE_BLOC) vider();
+}
+
+bool FluxStatistiques::decoder(const uint8_t*& debut, const uint8_t* fin, long long& generation, StatistiquesGeneration& stats) {
+    uint64_t champs[9];
+    for (uint64_t& champ : champs) {
+        if (!lireVarint(debut, fin, champ)) return false;
+    }
+    generation += (long long)champs[0];
+    stats.population += dezigzag(champs[1]);
+    stats.naissances = (long long)champs[2];
+    stats.morts = (long long)champs[3];
+    stats.tuilesModifiees = (long long)champs[4] - 1;
+    stats.ligneMin += (int)dezigzag(champs[5]);
+    stats.ligneMax += (int)dezigzag(champs[6]);
+    stats.colonneMin += (int)dezigzag(champs[7]);
+    stats.colonneMax += (int)dezigzag(champs[8]);
+    return true;
+}
+
+bool FluxStatistiques::lireFichier(const string& chemin, vector<uint8_t>& octets) {
+    ifstream entree(chemin, ios::binary);
+    if (!entree.is_open()) return false;
+    octets.assign(istreambuf_iterator<char>(entree), istreambuf_iterator<char>());
+    return octets.size() >= TAILLE_ENTETE_STATISTIQUES && equal(MAGIC_STATISTIQUES, MAGIC_STATISTIQUES + 4, (const char*)octets.data())
+        && lireFixe<uint32_t>(octets.data() + 4) == VERSION_STATISTIQUES;
+}
+
+// Les enregistrements suivant le point de reprise (exécution interrompue) sont retirés du fichier
+void FluxStatistiques::reprendre(const string& chemin, long long generation) {
+    fermer();
+    vector<uint8_t> octets;
+    if (!lireFichier(chemin, octets)) {
+        cerr << "Erreur : Flux de statistiques " << chemin << " absent ou invalide" << endl;
+        exit(1);
+    }
+    const uint8_t* debut = octets.data() + TAILLE_ENTETE_STATISTIQUES;
+    const uint8_t* fin = octets.data() + octets.size();
+    long long lue = 0;
+    StatistiquesGeneration stats;
+    generationPrecedente = 0;
+    precedentes = StatistiquesGeneration();
+    size_t taille = TAILLE_ENTETE_STATISTIQUES;
+    bool atteinte = false;
+    while (debut < fin && decoder(debut, fin, lue, stats) && lue <= generation) {
+        generationPrecedente = lue;
+        precedentes = stats;
+        taille = debut - octets.data();
+        atteinte = lue == generation;
+    }
+    if (!atteinte) {
+        cerr << "Erreur : Flux de statistiques " << chemin << " incomplet avant la generation " << generation << endl;
+        exit(1);
+    }
+    error_code erreur;
+    std::filesystem::resize_file(chemin, taille, erreur);
+    fichier.open(chemin, ios::binary | ios::in | ios::out);
+    if (erreur || !fichier.is_open()) {
+        cerr << "Erreur : Impossible de reprendre " << chemin << endl;
+        exit(1);
+    }
+    fichier.seekp(0, ios::end);
+    tampon.clear();
+}
+
+void FluxStatistiques::vider() {
+    if (!fichier.is_open()) return;
+    fichier.write((const char*)tampon.data(), tampon.size());
+    COMPTER(Compteur::OctetsEcrits, tampon.size());
+    tampon.clear();
+    fichier.flush();
+}
+
+void FluxStatistiques::fermer() {
+    if (!fichier.is_open()) return;
+    vider();
+    fichier.close();
+}
+
+void FluxStatistiques::exporterCsv(const string& chemin, const string& sortie) {
+    vector<uint8_t> octets;
+    if (!lireFichier(chemin, octets)) {
+        cerr << "Erreur : Flux de statistiques " << chemin << " absent ou invalide" << endl;
+        exit(1);
+    }
+    ofstream csv(sortie);
+    if (!csv.is_open()) {
+        cerr << "Erreur : Impossible de creer " << sortie << endl;
+        exit(1);
+    }
+    csv << "generation,population,naissances,morts,tuiles_modifiees,ligne_min,ligne_max,colonne_min,colonne_max\n";
+    const uint8_t* debut = octets.data() + TAILLE_ENTETE_STATISTIQUES;
+    const uint8_t* fin = octets.data() + octets.size();
+    long long generation = 0, lignes = 0;
+    StatistiquesGeneration stats;
+    while (debut < fin && decoder(debut, fin, generation, stats)) {
+        csv << generation << "," << stats.population << "," << stats.naissances << "," << stats.morts << ","
+            << stats.tuilesModifiees << "," << stats.ligneMin << "," << stats.ligneMax << ","
+            << stats.colonneMin << "," << stats.colonneMax << "\n";
+        lignes++;
+    }
+    cout << lignes << " generation(s) exportee(s) dans " << sortie << endl;
+}
@@ -0,0 +1,41 @@
+#ifndef FLUXSTATISTIQUES_H
+#define FLUXSTATISTIQUES_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "Moteur.h"
+
+// Série temporelle des statistiques de génération (population, naissances, morts, tuiles modifiées,
+// boîte englobante) dans un fichier compact, sans jamais écrire la grille.
+// En-tête : "JDVS", version. Un enregistrement par génération, chaque champ en entier de longueur variable :
+// écart de génération, puis population et boîte englobante par différence avec l'enregistrement précédent
+// (codage zigzag), naissances, morts et tuiles modifiées + 1 telles quelles. Quelques octets par génération.
+const char MAGIC_STATISTIQUES[4] = {'J', 'D', 'V', 'S'};
+const uint32_t VERSION_STATISTIQUES = 1;
+
+class FluxStatistiques {
+private:
+    std::ofstream fichier;
+    std::vector<uint8_t> tampon;        // Enregistrements en attente, écrits par blocs
+    long long generationPrecedente;
+    StatistiquesGeneration precedentes; // Base des différences du prochain enregistrement
+
+    // Lit un enregistrement : generation et stats contiennent l'enregistrement précédent et sont mis à jour
+    static bool decoder(const uint8_t*& debut, const uint8_t* fin, long long& generation, StatistiquesGeneration& stats);
+    static bool lireFichier(const std::string& chemin, std::vector<uint8_t>& octets); // Faux si l'en-tête est invalide
+
+public:
+    FluxStatistiques();
+    ~FluxStatistiques();
+    void ouvrir(const std::string& chemin);
+    void reprendre(const std::string& chemin, long long generation); // Tronque après la génération d'un point de reprise
+    void ajouter(long long generation, const StatistiquesGeneration& stats); // Générations croissantes
+    void vider();
+    void fermer();
+    bool estOuvert() const;
+    static void exporterCsv(const std::string& chemin, const std::string& sortie); // Une ligne CSV par génération
+};
+
+#endif // FLUXSTATISTIQUES_H
@@ -1,171 +1,185 @@
 #include "Grille.h"
-#include <SFML/Graphics.hpp> // Bibliothèque utilisée pour l'affichage graphique
+#include "Chargeur.h"
+#include "Instrumentation.h"
 #include <iostream>          // Pour l'entrée et la sortie standard
 #include <vector>            // Pour gérer la grille en tant que matrice 2D
-#include <set>               // Pour stocker les configurations uniques de la grille
 #include <fstream>           // Pour lire et écrire des fichiers
 #include <filesystem>        // Pour la gestion des fichiers et des dossiers
 #include <sstream>           // Pour manipuler des chaînes de caractères
 #include <chrono>            // Pour gérer le temps et les délais
+#include <random>            // Pour générer une soupe aléatoire
 
 using namespace std;
 using namespace chrono;       // Simplifie l'utilisation des types liés au temps
 namespace fs = std::filesystem; // Simplifie l'accès aux fonctionnalités de filesystem
 
 // Constructeur
-Grille::Grille(int nbLignes, int nbColonnes)
-    : nbLignes(nbLignes), nbColonnes(nbColonnes),
-      grille(nbLignes, std::vector<bool>(nbColonnes, false)) {}
-std::string Grille::getConfigurationString() const{
-        stringstream ss;
-        for (const auto& row : grille) {
-            for (bool ligne : row) {
-                ss << (ligne ? "1" : "0"); // Ajoute '1' si la cellule est vivante, '0' sinon
-            }
-        }
-        return ss.str(); // Retourne la chaîne correspondant à l'état actuel
+Grille::Grille(int nbLignes, int nbColonnes, TypeMoteur type, int nbThreads)
+    : nbLignes(nbLignes), nbColonnes(nbColonnes), moteur(creerMoteur(type, nbThreads)),
+      etat(nbLignes, nbColonnes), etatAJour(true), detectionCycles(true) {
+    moteur->charger(etat);
+    detecteur.initialiser(etat);
+}
+
+// Retourne la génération courante, recopiée depuis le moteur seulement si elle a changé
+const GrilleBits& Grille::getEtat() const {
+    if (!etatAJour) {
+        moteur->exporter(etat);
+        etatAJour = true;
     }
+    return etat;
+}
 
-// Méthode pour charger une grille depuis un fichier
-void Grille::ficher(const std::string& filename) {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cout << "Erreur : Impossible d'ouvrir le fichier !" << endl;
-            exit(1); // Termine le programme si le fichier ne peut pas être ouvert
-        }
+// Méthode pour charger une grille depuis un fichier (matrice 0/1, RLE ou .cells, voir Chargeur)
+void Grille::ficher(const std::string& filename, int lignesMin, int colonnesMin, std::string* regleMotif) {
+        Chargeur::chargerFichier(filename, etat, lignesMin, colonnesMin, regleMotif); // Lecture directe dans la grille compacte
+        nbLignes = etat.getNbLignes();
+        nbColonnes = etat.getNbColonnes();
+
+        moteur->charger(etat); // Transmet la configuration initiale au moteur
+        etatAJour = true;
+        detecteur.initialiser(etat); // Ajoute la configuration initiale à l'historique
+}
 
-        file >> nbLignes >> nbColonnes; // Lit les dimensions de la grille depuis le fichier
-        if (nbLignes <= 0 || nbColonnes <= 0) {
-         cout<<"Fichier de configuration invalide."<<endl;
+// Génère une grille aléatoire : chaque cellule est vivante avec la probabilité densite
+void Grille::aleatoire(int lignes, int colonnes, double densite, uint64_t graine) {
+        if (lignes <= 0 || colonnes <= 0) {
+         cout<<"Dimensions de la grille aleatoire invalides."<<endl;
          exit(1);}
-        grille.resize(nbLignes, vector<bool>(nbColonnes, false)); // Redimensionne la grille
+        nbLignes = lignes;
+        nbColonnes = colonnes;
+        etat.redimensionner(nbLignes, nbColonnes);
 
+        mt19937_64 generateur(graine); // Même graine, même soupe
+        bernoulli_distribution tirage(densite);
         for (int i = 0; i < nbLignes; ++i) {
             for (int j = 0; j < nbColonnes; ++j) {
-                int state;
-                file >> state; // Lit l'état de chaque cellule (0 ou 1)
-                grille[i][j] = (state == 1); // Affecte l'état à la cellule
-                if (grille[i][j]) cellulesVivantes.insert(Position(i, j)); // Ajoute la cellule à l'ensemble si elle est vivante
+                if (tirage(generateur)) etat.set(i, j, true);
             }
         }
 
-        file.close(); // Ferme le fichier après lecture
-        configurations.insert(getConfigurationString()); 
+        moteur->charger(etat);
+        etatAJour = true;
+        detecteur.initialiser(etat);
 }
 
-// Mise à jour de la grille
-void Grille::notifierVoisines(const Position& pos, std::map<Position, int>& nombreDeVoisins){
-        for (int dx = -1; dx <= 1; ++dx) {       // Parcourt les 8 voisins potentiels (y compris diagonales)
-            for (int dy = -1; dy <= 1; ++dy) {
-                if (dx == 0 && dy == 0) continue; // Ignore la cellule elle-même
+void Grille::setDetectionCycles(bool active) { detectionCycles = active; }
 
-                // Calcul des coordonnées voisines avec gestion de la grille torique
-                int nx = (pos.getX() + dx + nbLignes) % nbLignes; // Gestion des bords pour la coordonnée x
-                int ny = (pos.getY() + dy + nbColonnes) % nbColonnes; // Gestion des bords pour la coordonnée y
+void Grille::setRegle(const RegleVie& regle) { moteur->setRegle(regle); }
 
-                nombreDeVoisins[Position(nx, ny)]++; // Incrémente le nombre de voisins pour cette position
-            }
-        }
-    }
+void Grille::setSuiviStatistiques(bool actif) { moteur->suivreStatistiques(actif); }
 
+void Grille::setProfondeur(int profondeur) { moteur->setProfondeur(profondeur); }
 
-bool Grille::updateGrille() {
-        map<Position, int> nombreDeVoisins; // Compte le nombre de voisins de chaque cellule
+void Grille::statistiques(StatistiquesGeneration& stats) const { moteur->statistiques(stats); }
 
-        // Parcourt les cellules vivantes pour notifier le nombre de voisines à leurs voisines
-        for (const auto& pos : cellulesVivantes) {
-            notifierVoisines(pos, nombreDeVoisins);
+// Mise à jour de la grille
+bool Grille::updateGrille() {
+        {
+            MESURER_PHASE(Phase::Etape);
+            MESURER_NOYAU();
+            moteur->etape(); // Calcule la génération suivante avec le moteur choisi
         }
+        etatAJour = false;
+        if (!detectionCycles) return true;
 
-        set<Position> nouvellesCellulesVivantes; // Ensemble des nouvelles cellules vivantes
-
-        // Applique les règles du jeu aux cellules ayant des voisins
-        for (const auto& [pos, count] : nombreDeVoisins) {    // découpe nombreDeVoisins pour prendre d'un coté la position (x,y) de la cellule et de l'autre coté le nombre de voisin qu'elle possède (count)
-            bool estVivante = grille[pos.getX()][pos.getY()]; 
-            if (regle.application(estVivante, count)) {
-                nouvellesCellulesVivantes.insert(pos); // Ajoute les cellules qui deviennent vivantes
-            } 
+        // Vérifie si la configuration est répétée à partir des cellules qui ont changé
+        {
+            MESURER_PHASE(Phase::Changements);
+            moteur->cellulesChangees(changements);
         }
-        
+        MESURER_PHASE(Phase::Detection);
+        if (detecteur.enregistrer(changements, *moteur)) return false; // Si la configuration est identique, la grille est stabilisée
 
-        // Met à jour la grille avec les nouvelles cellules vivantes
-        grille.assign(nbLignes, vector<bool>(nbColonnes, false)); // Réinitialise la grille
-        for (const auto& pos : nouvellesCellulesVivantes) {
-            grille[pos.getX()][pos.getY()] = true; // Active les cellules vivantes
+        return true; // La grille a évolué
         }
-        cellulesVivantes = nouvellesCellulesVivantes; // Met à jour l'ensemble des cellules vivantes
 
-        // Vérifie si la configuration est répétée
-        string currentConfiguration = getConfigurationString();
-        if (configurations.count(currentConfiguration)) return false; // Si la configuration est identique, la grille est stabilisée
+void Grille::capturerHistorique(HistoriqueCycles& copie) { detecteur.capturer(copie); }
 
-        configurations.insert(currentConfiguration); // Ajoute la nouvelle configuration à l'historique
-        return true; // La grille a évolué
-        }
+// Reprise d'une simulation interrompue : la règle du point de reprise doit déjà être appliquée au moteur
+bool Grille::reprendre(const GrilleBits& etatReprise, const HistoriqueCycles& historique) {
+        etat = etatReprise;
+        nbLignes = etat.getNbLignes();
+        nbColonnes = etat.getNbColonnes();
+        moteur->charger(etat);
+        etatAJour = true;
+        return detecteur.restaurer(historique);
+}
+
+// Saut de plusieurs générations : l'historique des configurations repart de la génération atteinte
+void Grille::avancer(long long n) {
+        moteur->avancer(n);
+        etatAJour = false;
+        if (detectionCycles) detecteur.initialiser(getEtat()); // Sinon la grille n'est exportée qu'à la demande
+}
 
 // Sauvegarde une itération
 void Grille::saveIteration(int iteration, const std::string& folderPath) {
-            stringstream filename;
+        ecrireIteration(getEtat(), iteration, folderPath);
+}
+
+// Écrit une génération au format texte historique (utilisé aussi pour exporter une archive)
+void Grille::ecrireIteration(const GrilleBits& courant, long long iteration, const std::string& folderPath) {
+        stringstream filename;
         filename << folderPath << "/iteration_" << iteration << ".txt"; // Crée le nom du fichier pour cette itération
         ofstream file(filename.str());
 
         // Écrit les informations dans le fichier
         file << "Iteration: " << iteration << "\n";
-        file << "Cellules vivantes: " << cellulesVivantes.size() << "\n";
-        file << "Dimensions: " << nbLignes << "x" << nbColonnes << "\n";
+        file << "Cellules vivantes: " << courant.population() << "\n";
+        file << "Dimensions: " << courant.getNbLignes() << "x" << courant.getNbColonnes() << "\n";
 
         // Écrit l'état de la grille ligne par ligne
-        for (int i = 0; i < nbLignes; ++i) {
-            for (int j = 0; j < nbColonnes; ++j) {
-                file << (grille[i][j] ? "1 " : "0 "); // Écrit '1' pour vivante, '0' pour morte
+        for (int i = 0; i < courant.getNbLignes(); ++i) {
+            for (int j = 0; j < courant.getNbColonnes(); ++j) {
+                file << (courant.get(i, j) ? "1 " : "0 "); // Écrit '1' pour vivante, '0' pour morte
             }
             file << "\n";
         }
+        COMPTER(Compteur::OctetsEcrits, file.tellp());
 }
 
 // Sauvegarde l'état stabilisé
 void Grille::saveStabilisation(int iteration, const std::string& folderPath) {
+        ecrireStabilisation(getEtat(), iteration, folderPath);
+}
+
+void Grille::ecrireStabilisation(const GrilleBits& courant, long long iteration, const std::string& folderPath) {
         stringstream filename;
         filename << folderPath << "/stabilisation_iteration_" << iteration << ".txt";
         ofstream file(filename.str());
 
         // Écrit les informations de stabilisation
         file << "Stabilisation à l'iteration: " << iteration << "\n";
-        file << "Cellules vivantes: " << cellulesVivantes.size() << "\n";
-        file << "Dimensions: " << nbLignes << "x" << nbColonnes << "\n";
+        file << "Cellules vivantes: " << courant.population() << "\n";
+        file << "Dimensions: " << courant.getNbLignes() << "x" << courant.getNbColonnes() << "\n";
 
         // Écrit l'état de la grille ligne par ligne
-        for (int i = 0; i < nbLignes; ++i) {
-            for (int j = 0; j < nbColonnes; ++j) {
-                file << (grille[i][j] ? "1 " : "0 ");
+        for (int i = 0; i < courant.getNbLignes(); ++i) {
+            for (int j = 0; j < courant.getNbColonnes(); ++j) {
+                file << (courant.get(i, j) ? "1 " : "0 ");
             }
             file << "\n";
         }
+        COMPTER(Compteur::OctetsEcrits, file.tellp());
 }
 
-// Affichage graphique
-void Grille::afficherGraphique(sf::RenderWindow& window, sf::Text& text, int pixelSize, int iteration) {
+#ifdef JDV_FENETRE
+// Affichage graphique : la grille est une texture dessinée en un seul appel (voir RenduGrille).
+// Seul le rendu est utilisé ici, le moteur peut calculer en même temps sur un autre thread.
+void Grille::afficherGraphique(sf::RenderWindow& window, sf::Text& text, int pixelSize, const GrilleBits& image,
+                               const std::string& legende) {
         window.clear(sf::Color::Black); 
-        text.setString("Iteration : " + to_string(iteration)); 
-        sf::RectangleShape cell(sf::Vector2f(pixelSize - 1.0f, pixelSize - 1.0f)); 
-
-        // Dessine les cellules vivantes
-        for (int i = 0; i < nbLignes; ++i) {
-            for (int j = 0; j < nbColonnes; ++j) {
-                if (grille[i][j]) {
-                    cell.setFillColor(sf::Color::White);}
-                else{
-                    cell.setFillColor(sf::Color::Black);}
-                    cell.setPosition(j * pixelSize, i * pixelSize);
-                    window.draw(cell); // Ajoute la cellule à la fenêtre
-                }
-            }
-            window.draw(text); // Dessine le texte sur la fenêtre
-            window.display(); // Met à jour l'affichage graphique
-        }
-
-        
+        text.setString(legende); 
+        rendu.dessiner(window, image, pixelSize); // Seules les lignes modifiées sont renvoyées à la carte graphique
+        window.draw(text); // Dessine le texte sur la fenêtre
+        window.display(); // Met à jour l'affichage graphique
+}
+#endif
 
 int Grille::getNbLignes() const { return nbLignes; }
 int Grille::getNbColonnes() const { return nbColonnes; }
+int Grille::getPeriode() const { return detecteur.getPeriode(); }
+const Moteur& Grille::getMoteur() const { return *moteur; }
+long long Grille::getTuilesCalculees() const { return moteur->tuilesCalculees(); }
 
@@ -2,33 +2,58 @@
 #define GRILLE_H
 
 #include <vector>
-#include <set>
-#include <map>
 #include <string>
-#include "Position.h"
-#include "Regle.h"
-#include <SFML/Graphics.hpp> 
+#include <memory>
+#include "Moteur.h"
+#include "GrilleBits.h"
+#include "DetecteurCycle.h"
+#ifdef JDV_FENETRE
+#include "RenduGrille.h"
+#include <SFML/Graphics.hpp>
+#endif
 
 
 class Grille {
 private:
     int nbLignes, nbColonnes;
-    std::vector<std::vector<bool>> grille;
-    std::set<Position> cellulesVivantes;
-    std::set<std::string> configurations;
-    RegleSt regle;
+    std::unique_ptr<Moteur> moteur;   // Moteur de calcul choisi (creux, dense, hashlife, parallele ou plan)
+    mutable GrilleBits etat;          // Copie de la génération courante pour les sorties
+    mutable bool etatAJour;           // Vrai si etat correspond à la génération du moteur
+    DetecteurCycle detecteur;         // Historique borné des configurations (empreintes)
+    std::vector<uint64_t> changements; // Cellules basculées lors de la dernière mise à jour
+#ifdef JDV_FENETRE
+    RenduGrille rendu;                // Texture de la grille pour l'affichage
+#endif
+    bool detectionCycles;             // Faux : aucune détection de répétition (mesures de performance)
 
 public:
-    Grille(int nbLignes, int nbColonnes);
-    void ficher(const std::string& filename);
-    void notifierVoisines(const Position& pos, std::map<Position, int>& nombreDeVoisins);
-    std::string getConfigurationString() const;
+    Grille(int nbLignes, int nbColonnes, TypeMoteur type = TypeMoteur::Creux, int nbThreads = 0);
+    void ficher(const std::string& filename, int lignesMin = 0, int colonnesMin = 0, // Dimensions minimales du tore pour RLE et .cells
+                std::string* regleMotif = nullptr); // Champ rule d'un motif RLE
+    void aleatoire(int lignes, int colonnes, double densite, uint64_t graine); // Soupe aléatoire reproductible
+    void setDetectionCycles(bool active);
+    void setRegle(const RegleVie& regle); // Règle B/S du moteur (B3/S23 par défaut)
+    void setSuiviStatistiques(bool actif); // Statistiques tenues à jour par le moteur pendant l'étape
+    void setProfondeur(int profondeur);    // Générations par passage de la grille dans avancer (blocage temporel)
+    void statistiques(StatistiquesGeneration& stats) const; // Statistiques de la génération courante
+    const GrilleBits& getEtat() const;
     bool updateGrille();
+    void capturerHistorique(HistoriqueCycles& copie); // Historique de la détection de cycles (point de reprise)
+    bool reprendre(const GrilleBits& etatReprise, const HistoriqueCycles& historique); // Faux si l'historique est invalide
+    void avancer(long long n); // Saute directement n générations (Hashlife : 2^k générations par appel)
     void saveIteration(int iteration, const std::string& folderPath);
+    static void ecrireIteration(const GrilleBits& etat, long long iteration, const std::string& folderPath); // Format texte historique
     void saveStabilisation(int iteration, const std::string& folderPath);
-    void afficherGraphique(sf::RenderWindow& window, sf::Text& text, int pixelSize, int iteration);
+    static void ecrireStabilisation(const GrilleBits& etat, long long iteration, const std::string& folderPath);
+#ifdef JDV_FENETRE
+    void afficherGraphique(sf::RenderWindow& window, sf::Text& text, int pixelSize, const GrilleBits& image,
+                           const std::string& legende); // image : copie publiée par le thread de calcul
+#endif
     int getNbLignes() const;
     int getNbColonnes() const;
+    int getPeriode() const; // Période du cycle détecté (1 pour une configuration fixe)
+    const Moteur& getMoteur() const; // Moteur de calcul (lecture seule, pour les mesures)
+    long long getTuilesCalculees() const; // Tuiles recalculées par le moteur (-1 si le moteur n'en a pas)
 };
 
 #endif // GRILLE_H
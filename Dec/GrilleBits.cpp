@@ -0,0 +1,65 @@
+#include "GrilleBits.h"
+#include <algorithm>
+#include <cstring>
+
+GrilleBits::GrilleBits(int nbLignes, int nbColonnes)
+    : nbLignes(0), nbColonnes(0), motsParLigne(0) {
+    redimensionner(nbLignes, nbColonnes);
+}
+
+// Redimensionne la grille et la remet à zéro
+void GrilleBits::redimensionner(int nbLignes, int nbColonnes) {
+    this->nbLignes = nbLignes;
+    this->nbColonnes = nbColonnes;
+    motsParLigne = (nbColonnes + 63) / 64;
+    mots.assign((size_t)nbLignes * motsParLigne, 0);
+}
+
+void GrilleBits::effacer() {
+    std::fill(mots.begin(), mots.end(), 0);
+}
+
+// Nombre de cellules vivantes (comptage des bits à 1)
+long long GrilleBits::population() const {
+    long long total = 0;
+    for (uint64_t mot : mots) total += __builtin_popcountll(mot);
+    return total;
+}
+
+int GrilleBits::getNbLignes() const { return nbLignes; }
+int GrilleBits::getNbColonnes() const { return nbColonnes; }
+int GrilleBits::getMotsParLigne() const { return motsParLigne; }
+
+uint64_t GrilleBits::masqueDernierMot() const {
+    int reste = nbColonnes - 64 * (motsParLigne - 1); // Colonnes occupées dans le dernier mot (1 à 64)
+    return reste >= 64 ? ~0ULL : ((1ULL << reste) - 1);
+}
+
+void GrilleBits::serialiser(std::vector<uint8_t>& sortie) const {
+    int32_t dimensions[2] = {nbLignes, nbColonnes};
+    size_t taille = sortie.size();
+    sortie.resize(taille + sizeof(dimensions) + mots.size() * sizeof(uint64_t));
+    memcpy(sortie.data() + taille, dimensions, sizeof(dimensions));
+    if (!mots.empty()) memcpy(sortie.data() + taille + sizeof(dimensions), mots.data(), mots.size() * sizeof(uint64_t));
+}
+
+bool GrilleBits::restaurer(const uint8_t*& debut, const uint8_t* fin) {
+    int32_t dimensions[2];
+    if (fin - debut < (std::ptrdiff_t)sizeof(dimensions)) return false;
+    memcpy(dimensions, debut, sizeof(dimensions));
+    if (dimensions[0] < 0 || dimensions[1] < 0) return false;
+    size_t taille = (size_t)dimensions[0] * ((dimensions[1] + 63) / 64) * sizeof(uint64_t);
+    if ((size_t)(fin - debut) - sizeof(dimensions) < taille) return false;
+    redimensionner(dimensions[0], dimensions[1]);
+    if (taille > 0) memcpy(mots.data(), debut + sizeof(dimensions), taille);
+    debut += sizeof(dimensions) + taille;
+    return true;
+}
+
+bool GrilleBits::operator==(const GrilleBits& other) const {
+    return nbLignes == other.nbLignes && nbColonnes == other.nbColonnes && mots == other.mots;
+}
+
+bool GrilleBits::operator!=(const GrilleBits& other) const {
+    return !(*this == other);
+}
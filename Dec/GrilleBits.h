@@ -0,0 +1,45 @@
+#ifndef GRILLEBITS_H
+#define GRILLEBITS_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Grille compacte : un bit par cellule, chaque ligne occupe un nombre entier de mots de 64 bits.
+// Les bits au-delà de la dernière colonne d'une ligne sont toujours à zéro.
+class GrilleBits {
+private:
+    int nbLignes, nbColonnes;
+    int motsParLigne;           // Nombre de mots de 64 bits par ligne
+    std::vector<uint64_t> mots; // Cellules rangées ligne après ligne (bit j du mot k = colonne 64k + j)
+
+public:
+    GrilleBits(int nbLignes = 0, int nbColonnes = 0);
+    void redimensionner(int nbLignes, int nbColonnes);
+    void effacer();
+    long long population() const;
+
+    bool get(int x, int y) const {
+        return (mots[(std::size_t)x * motsParLigne + (y >> 6)] >> (y & 63)) & 1;
+    }
+    void set(int x, int y, bool vivante) {
+        uint64_t& mot = mots[(std::size_t)x * motsParLigne + (y >> 6)];
+        if (vivante) mot |= (1ULL << (y & 63));
+        else mot &= ~(1ULL << (y & 63));
+    }
+    uint64_t* ligne(int x) { return mots.data() + (std::size_t)x * motsParLigne; }
+    const uint64_t* ligne(int x) const { return mots.data() + (std::size_t)x * motsParLigne; }
+
+    int getNbLignes() const;
+    int getNbColonnes() const;
+    int getMotsParLigne() const;
+    uint64_t masqueDernierMot() const; // Bits valides du dernier mot de chaque ligne
+
+    void serialiser(std::vector<uint8_t>& sortie) const;              // Dimensions puis mots (points de reprise)
+    bool restaurer(const uint8_t*& debut, const uint8_t* fin);        // Faux si les données sont tronquées
+
+    bool operator==(const GrilleBits& other) const;
+    bool operator!=(const GrilleBits& other) const;
+};
+
+#endif // GRILLEBITS_H
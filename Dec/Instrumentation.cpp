@@ -0,0 +1,183 @@
+#include "Instrumentation.h"
+#include "Mesures.h"
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char* NOMS_PHASES[] = {"etape", "notification", "regle", "reconstruction", "changements", "detection",
+                             "sauvegarde", "ecriture", "affichage"};
+const int NB_PHASES = (int)Phase::Nombre;
+const int NB_COMPTEURS = (int)Compteur::Nombre;
+const int NB_MATERIELS = 3; // Cycles, instructions, défauts de cache
+const char* NOMS_MATERIELS[] = {"cycles", "instructions", "defauts_cache"};
+
+std::atomic<bool> active(false);
+std::atomic<uint64_t> durees[NB_PHASES];
+std::atomic<uint64_t> compteurs[NB_COMPTEURS];
+std::ofstream sortie;
+bool formatJson = false;
+int intervalle = 1;
+long long allocationsPrecedentes = 0, tuilesPrecedentes = 0;
+
+// Groupe perf_event : le premier descripteur mène le groupe
+int descripteurs[NB_MATERIELS] = {-1, -1, -1};
+uint64_t materielsPrecedents[NB_MATERIELS] = {0, 0, 0};
+
+bool ouvrirMateriel() {
+#ifdef __linux__
+    const uint64_t configs[NB_MATERIELS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+    for (int i = 0; i < NB_MATERIELS; ++i) {
+        perf_event_attr attributs;
+        memset(&attributs, 0, sizeof(attributs));
+        attributs.type = PERF_TYPE_HARDWARE;
+        attributs.size = sizeof(attributs);
+        attributs.config = configs[i];
+        attributs.disabled = i == 0; // Le groupe démarre arrêté
+        attributs.exclude_kernel = 1;
+        attributs.exclude_hv = 1;
+        attributs.read_format = PERF_FORMAT_GROUP;
+        descripteurs[i] = (int)syscall(SYS_perf_event_open, &attributs, 0, -1, i == 0 ? -1 : descripteurs[0], 0);
+        if (descripteurs[i] < 0) {
+            for (int j = 0; j < i; ++j) close(descripteurs[j]);
+            for (int& d : descripteurs) d = -1;
+            return false;
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Valeurs cumulées du groupe (nombre d'événements puis une valeur par événement)
+bool lireMateriel(uint64_t valeurs[NB_MATERIELS]) {
+#ifdef __linux__
+    uint64_t tampon[1 + NB_MATERIELS];
+    if (descripteurs[0] < 0 || read(descripteurs[0], tampon, sizeof(tampon)) != (ssize_t)sizeof(tampon)) return false;
+    for (int i = 0; i < NB_MATERIELS; ++i) valeurs[i] = tampon[1 + i];
+    return true;
+#else
+    (void)valeurs;
+    return false;
+#endif
+}
+
+} // namespace
+
+bool Instrumentation::compileeAvecInstrumentation() {
+#ifdef JDV_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool Instrumentation::ouvrir(const std::string& chemin, bool json, int n, bool materiel) {
+    fermer();
+    sortie.open(chemin);
+    if (!sortie.is_open()) return false;
+    formatJson = json;
+    intervalle = n > 0 ? n : 1;
+    for (auto& d : durees) d = 0;
+    for (auto& c : compteurs) c = 0;
+    allocationsPrecedentes = nombreAllocations();
+    tuilesPrecedentes = 0;
+    for (uint64_t& v : materielsPrecedents) v = 0;
+    if (materiel && !ouvrirMateriel()) {
+        std::cerr << "Compteurs materiels indisponibles (perf_event_open refuse, voir /proc/sys/kernel/perf_event_paranoid)" << std::endl;
+    }
+
+    if (!formatJson) {
+        sortie << "generation";
+        for (const char* nom : NOMS_PHASES) sortie << "," << nom << "_ns";
+        sortie << ",cellules_vivantes,cellules_candidates,tuiles_calculees,allocations,octets_ecrits";
+        if (descripteurs[0] >= 0) {
+            for (const char* nom : NOMS_MATERIELS) sortie << "," << nom;
+        }
+        sortie << "\n";
+    }
+    active = true;
+    return true;
+}
+
+void Instrumentation::fermer() {
+    active = false;
+    if (sortie.is_open()) sortie.close();
+#ifdef __linux__
+    for (int& d : descripteurs) {
+        if (d >= 0) close(d);
+        d = -1;
+    }
+#endif
+}
+
+bool Instrumentation::estActive() { return active.load(std::memory_order_relaxed); }
+
+void Instrumentation::ajouterDuree(Phase phase, uint64_t nanosecondes) {
+    durees[(int)phase].fetch_add(nanosecondes, std::memory_order_relaxed);
+}
+
+void Instrumentation::compter(Compteur compteur, uint64_t n) {
+    if (estActive()) compteurs[(int)compteur].fetch_add(n, std::memory_order_relaxed);
+}
+
+void Instrumentation::debutNoyau() {
+#ifdef __linux__
+    if (descripteurs[0] >= 0) ioctl(descripteurs[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void Instrumentation::finNoyau() {
+#ifdef __linux__
+    if (descripteurs[0] >= 0) ioctl(descripteurs[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void Instrumentation::finGeneration(long long generation, const Moteur& moteur) {
+    if (!estActive() || generation % intervalle != 0) return;
+
+    uint64_t phases[NB_PHASES], valeurs[NB_COMPTEURS];
+    for (int i = 0; i < NB_PHASES; ++i) phases[i] = durees[i].exchange(0, std::memory_order_relaxed);
+    for (int i = 0; i < NB_COMPTEURS; ++i) valeurs[i] = compteurs[i].exchange(0, std::memory_order_relaxed);
+    long long allocations = nombreAllocations(), tuiles = moteur.tuilesCalculees();
+    long long nouvellesAllocations = allocations - allocationsPrecedentes;
+    long long nouvellesTuiles = tuiles >= 0 ? tuiles - tuilesPrecedentes : -1;
+    allocationsPrecedentes = allocations;
+    if (tuiles >= 0) tuilesPrecedentes = tuiles;
+    uint64_t materiels[NB_MATERIELS];
+    bool avecMateriel = lireMateriel(materiels);
+    const long long population = moteur.population(); // Seulement aux lignes écrites : O(grille) pour les moteurs denses
+
+    if (formatJson) {
+        sortie << "{\"generation\": " << generation;
+        for (int i = 0; i < NB_PHASES; ++i) sortie << ", \"" << NOMS_PHASES[i] << "_ns\": " << phases[i];
+        sortie << ", \"cellules_vivantes\": " << population << ", \"cellules_candidates\": " << valeurs[(int)Compteur::CellulesCandidates]
+               << ", \"tuiles_calculees\": " << nouvellesTuiles << ", \"allocations\": " << nouvellesAllocations
+               << ", \"octets_ecrits\": " << valeurs[(int)Compteur::OctetsEcrits];
+        if (avecMateriel) {
+            for (int i = 0; i < NB_MATERIELS; ++i) sortie << ", \"" << NOMS_MATERIELS[i] << "\": " << materiels[i] - materielsPrecedents[i];
+        }
+        sortie << "}\n";
+    } else {
+        sortie << generation;
+        for (uint64_t duree : phases) sortie << "," << duree;
+        sortie << "," << population << "," << valeurs[(int)Compteur::CellulesCandidates] << "," << nouvellesTuiles << ","
+               << nouvellesAllocations << "," << valeurs[(int)Compteur::OctetsEcrits];
+        if (avecMateriel) {
+            for (int i = 0; i < NB_MATERIELS; ++i) sortie << "," << materiels[i] - materielsPrecedents[i];
+        }
+        sortie << "\n";
+    }
+    if (avecMateriel) {
+        for (int i = 0; i < NB_MATERIELS; ++i) materielsPrecedents[i] = materiels[i];
+    }
+}
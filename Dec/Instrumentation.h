@@ -0,0 +1,72 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <cstdint>
+#include <string>
+#include <chrono>
+#include "Moteur.h"
+
+// Instrumentation du chemin critique : durée de chaque phase (horloge monotone), compteurs (cellules vivantes,
+// candidates, tuiles, allocations, octets écrits) et, en option, compteurs matériels Linux (perf_event_open)
+// autour de l'étape du moteur. Une ligne CSV ou JSON est écrite toutes les N générations (valeurs cumulées
+// depuis la ligne précédente).
+// Les macros MESURER_PHASE, MESURER_NOYAU, COMPTER et INSTRUMENTER_GENERATION ne produisent du code qu'avec JDV_INSTRUMENTATION
+// (option CMake INSTRUMENTATION) : sans elle, l'instrumentation ne coûte rien.
+
+enum class Phase { Etape, Notification, Regle, Reconstruction, Changements, Detection, Sauvegarde, Ecriture, Affichage, Nombre };
+enum class Compteur { CellulesCandidates, OctetsEcrits, Nombre };
+
+class Instrumentation {
+public:
+    static bool ouvrir(const std::string& chemin, bool json, int intervalle, bool materiel); // False si le fichier ne s'ouvre pas
+    static void fermer();
+    static bool estActive();
+    static void ajouterDuree(Phase phase, uint64_t nanosecondes);
+    static void compter(Compteur compteur, uint64_t n);
+    static void debutNoyau(); // Compteurs matériels activés pendant l'étape du moteur seulement
+    static void finNoyau();
+    static void finGeneration(long long generation, const Moteur& moteur); // Écrit une ligne toutes les intervalle générations
+    static bool compileeAvecInstrumentation();
+};
+
+// Chronomètre d'une phase : la durée est ajoutée à la destruction
+class ChronoPhase {
+private:
+    Phase phase;
+    std::chrono::steady_clock::time_point debut;
+    bool actif;
+
+public:
+    explicit ChronoPhase(Phase phase) : phase(phase), actif(Instrumentation::estActive()) {
+        if (actif) debut = std::chrono::steady_clock::now();
+    }
+    ~ChronoPhase() {
+        if (actif) {
+            auto duree = std::chrono::steady_clock::now() - debut;
+            Instrumentation::ajouterDuree(phase, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(duree).count());
+        }
+    }
+};
+
+// Compteurs matériels autour d'une portée
+class ChronoNoyau {
+public:
+    ChronoNoyau() { Instrumentation::debutNoyau(); }
+    ~ChronoNoyau() { Instrumentation::finNoyau(); }
+};
+
+#ifdef JDV_INSTRUMENTATION
+#define JDV_CONCATENER2(a, b) a##b
+#define JDV_CONCATENER(a, b) JDV_CONCATENER2(a, b)
+#define MESURER_PHASE(phase) ChronoPhase JDV_CONCATENER(chronoPhase, __LINE__)(phase)
+#define MESURER_NOYAU() ChronoNoyau JDV_CONCATENER(chronoNoyau, __LINE__)
+#define COMPTER(compteur, n) Instrumentation::compter(compteur, (uint64_t)(n))
+#define INSTRUMENTER_GENERATION(generation, moteur) Instrumentation::finGeneration(generation, moteur)
+#else
+#define MESURER_PHASE(phase) ((void)0)
+#define MESURER_NOYAU() ((void)0)
+#define COMPTER(compteur, n) ((void)0)
+#define INSTRUMENTER_GENERATION(generation, moteur) ((void)0)
+#endif
+
+#endif // INSTRUMENTATION_H
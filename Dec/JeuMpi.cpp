@@ -0,0 +1,191 @@
+// Mode distribué : le tore est découpé en bandes de lignes entre les rangs MPI (mpirun -np N jeu_mpi ...).
+// La détection de stabilisation utilise l'empreinte globale (OU exclusif des empreintes des rangs),
+// confirmée exactement par comparaison des bandes une période plus tard.
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <iomanip>
+#include "DomaineMpi.h"
+#include "Chargeur.h"
+
+using namespace std;
+
+struct ParametresMpi {
+    string fichier;                  // Configuration initiale (lue par le rang 0 seul, puis répartie en bandes)
+    int lignes = 0, colonnes = 0;    // Soupe aléatoire si pas de fichier
+    double densite = 0.5;
+    unsigned long long graine = 1;
+    long long iterations = 100;
+    RegleVie regle;
+    bool regleImposee = false;       // --regle donnée : prioritaire sur la règle d'un motif RLE
+    bool detectionCycles = true;
+    string sortie;                   // Grille finale au format matrice (rassemblée sur le rang 0)
+};
+
+static void afficherUsageMpi(const string& programme) {
+    cout << "Usage : mpirun -np N " << programme << " [options]\n"
+         << "  --fichier F        configuration initiale (matrice, .rle ou .cells), lue par le rang 0\n"
+         << "                     qui envoie a chaque rang sa bande\n"
+         << "  --aleatoire LxC    soupe aleatoire de L lignes et C colonnes, chaque rang ne produit que sa bande\n"
+         << "  --densite P        pourcentage de cellules vivantes de la soupe (defaut 50)\n"
+         << "  --graine N         graine de la soupe (defaut 1)\n"
+         << "  --iterations N     nombre maximal de generations (defaut 100)\n"
+         << "  --regle R          regle B/S ou nom (defaut B3/S23)\n"
+         << "  --sans-cycle       desactive la detection des repetitions\n"
+         << "  --sortie F         ecrit la grille finale au format matrice (petites grilles)\n"
+         << "  --aide             affiche ce message" << endl;
+}
+
+static bool lireArgumentsMpi(int argc, char* argv[], ParametresMpi& parametres) {
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--aide") return false;
+        if (option == "--sans-cycle") { parametres.detectionCycles = false; continue; }
+        if (i + 1 >= argc) return false;
+        string valeur = argv[++i];
+        try {
+            if (option == "--fichier") parametres.fichier = valeur;
+            else if (option == "--aleatoire") {
+                size_t x = valeur.find('x');
+                if (x == string::npos) return false;
+                parametres.lignes = stoi(valeur.substr(0, x));
+                parametres.colonnes = stoi(valeur.substr(x + 1));
+            }
+            else if (option == "--densite") parametres.densite = stod(valeur) / 100.0;
+            else if (option == "--graine") parametres.graine = stoull(valeur);
+            else if (option == "--iterations") parametres.iterations = stoll(valeur);
+            else if (option == "--regle") {
+                if (!RegleVie::lire(valeur, parametres.regle)) return false;
+                parametres.regleImposee = true;
+            }
+            else if (option == "--sortie") parametres.sortie = valeur;
+            else return false;
+        } catch (...) {
+            return false;
+        }
+    }
+    return !parametres.fichier.empty() || (parametres.lignes > 0 && parametres.colonnes > 0);
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    int rang = 0, nbRangs = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rang);
+    MPI_Comm_size(MPI_COMM_WORLD, &nbRangs);
+
+    ParametresMpi parametres;
+    if (!lireArgumentsMpi(argc, argv, parametres)) {
+        if (rang == 0) afficherUsageMpi(argv[0]);
+        MPI_Finalize();
+        return 1;
+    }
+
+    // Fichier : seul le rang 0 tient la grille complète ; dimensions et règle sont diffusées aux autres rangs
+    GrilleBits complet;
+    if (!parametres.fichier.empty()) {
+        int entete[4] = {0, 0, 0, 0}; // Lignes, colonnes, naissance, survie
+        if (rang == 0) {
+            string regleMotif;
+            Chargeur::chargerFichier(parametres.fichier, complet, 0, 0, &regleMotif);
+            parametres.regle = Chargeur::choisirRegle(regleMotif, parametres.regle, parametres.regleImposee);
+            entete[0] = complet.getNbLignes();
+            entete[1] = complet.getNbColonnes();
+            entete[2] = parametres.regle.naissance;
+            entete[3] = parametres.regle.survie;
+        }
+        MPI_Bcast(entete, 4, MPI_INT, 0, MPI_COMM_WORLD);
+        parametres.lignes = entete[0];
+        parametres.colonnes = entete[1];
+        parametres.regle = RegleVie((uint16_t)entete[2], (uint16_t)entete[3]);
+    }
+    if (parametres.lignes < nbRangs) {
+        if (rang == 0) cerr << "Erreur : moins de lignes (" << parametres.lignes << ") que de rangs (" << nbRangs << ")" << endl;
+        MPI_Finalize();
+        return 1;
+    }
+
+    DomaineMpi domaine(MPI_COMM_WORLD, parametres.lignes, parametres.colonnes, parametres.regle);
+    if (!parametres.fichier.empty()) {
+        domaine.charger(complet);
+        complet = GrilleBits(); // Le rang 0 ne conserve que sa bande
+    } else {
+        domaine.remplirAleatoire(parametres.densite, parametres.graine);
+    }
+
+    // Historique des empreintes globales, identique sur tous les rangs : aucune diffusion nécessaire
+    const size_t capacite = 1 << 20;
+    unordered_map<Empreinte, long long, HachageEmpreinte> vues;
+    deque<pair<Empreinte, long long>> ordre;
+    GrilleBits instantane;
+    bool verificationEnCours = false;
+    long long generationInstantane = 0, periodeCandidate = 0, periode = 0;
+    auto memoriser = [&](const Empreinte& e, long long generation) {
+        vues[e] = generation;
+        ordre.emplace_back(e, generation);
+        if (ordre.size() > capacite) {
+            auto it = vues.find(ordre.front().first);
+            if (it != vues.end() && it->second == ordre.front().second) vues.erase(it);
+            ordre.pop_front();
+        }
+    };
+    if (parametres.detectionCycles) memoriser(domaine.empreinte(), 0);
+
+    double debut = MPI_Wtime();
+    long long generation = 0;
+    while (generation < parametres.iterations) {
+        domaine.etape();
+        ++generation;
+        if (!parametres.detectionCycles) continue;
+
+        if (verificationEnCours && generation == generationInstantane + periodeCandidate) {
+            verificationEnCours = false;
+            if (domaine.identique(instantane)) {
+                periode = periodeCandidate;
+                generation = generationInstantane; // Même génération que la détection d'un seul processus (même état)
+                break;
+            }
+        }
+        Empreinte e = domaine.empreinte();
+        auto it = vues.find(e);
+        if (it != vues.end() && !verificationEnCours) {
+            domaine.memoriser(instantane); // Candidat : confirmé si la bande revient à l'identique une période plus tard
+            generationInstantane = generation;
+            periodeCandidate = generation - it->second;
+            verificationEnCours = true;
+        }
+        memoriser(e, generation);
+    }
+    double secondes = MPI_Wtime() - debut;
+
+    long long population = domaine.population();
+    double calcul = domaine.getSecondesCalcul(), attente = domaine.getSecondesAttente(), calculMax = 0, attenteMax = 0;
+    MPI_Reduce(&calcul, &calculMax, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&attente, &attenteMax, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    Empreinte finale = domaine.empreinte();
+
+    if (!parametres.sortie.empty()) {
+        domaine.rassembler(complet);
+        if (rang == 0) {
+            ofstream fichier(parametres.sortie);
+            fichier << complet.getNbLignes() << " " << complet.getNbColonnes() << "\n";
+            for (int i = 0; i < complet.getNbLignes(); ++i) {
+                for (int j = 0; j < complet.getNbColonnes(); ++j) fichier << (complet.get(i, j) ? "1 " : "0 ");
+                fichier << "\n";
+            }
+        }
+    }
+
+    if (rang == 0) {
+        if (periode > 0) cout << "Simulation stabilisée à l'itération " << generation << " (période " << periode << ")" << endl;
+        cout << "Rangs : " << nbRangs << ", tore " << parametres.lignes << "x" << parametres.colonnes << endl;
+        cout << "Générations calculées : " << generation << endl;
+        cout << "Population : " << population << endl;
+        cout << "Empreinte : " << hex << setfill('0') << setw(16) << finale.a << setw(16) << finale.b << dec << endl;
+        cout << "Durée totale : " << fixed << setprecision(3) << secondes << " s (calcul max " << calculMax
+             << " s, attente des halos max " << attenteMax << " s)" << endl;
+    }
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "LecteurArchive.h"
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+static const size_t TAILLE_ENTETE = 20;       // Magic, version, lignes, colonnes, intervalle
+static const size_t TAILLE_PIED = 20;         // Position de l'index, nombre d'entrées, magic
+static const size_t TAILLE_ENTREE_INDEX = 17;
+
+LecteurArchive::LecteurArchive(const string& chemin) : nbLignes(0), nbColonnes(0), indiceCourant(-1) {
+    fichier.open(chemin, ios::binary);
+    if (!fichier.is_open()) {
+        cerr << "Erreur : Impossible d'ouvrir l'archive " << chemin << endl;
+        exit(1);
+    }
+
+    uint8_t entete[TAILLE_ENTETE];
+    if (!fichier.read((char*)entete, TAILLE_ENTETE) || memcmp(entete, MAGIC_ARCHIVE, 4) != 0
+        || lireFixe<uint32_t>(entete + 4) != VERSION_ARCHIVE) {
+        cerr << "Erreur : " << chemin << " n'est pas une archive de simulation valide" << endl;
+        exit(1);
+    }
+    nbLignes = lireFixe<int32_t>(entete + 8);
+    nbColonnes = lireFixe<int32_t>(entete + 12);
+    courant.redimensionner(nbLignes, nbColonnes);
+
+    fichier.seekg(0, ios::end);
+    uint64_t taille = (uint64_t)fichier.tellg();
+    if (!lireIndex(taille)) parcourir(TAILLE_ENTETE);
+}
+
+// Lit l'index écrit à la fermeture ; faux s'il est absent ou incohérent
+bool LecteurArchive::lireIndex(uint64_t taille) {
+    if (taille < TAILLE_ENTETE + TAILLE_PIED) return false;
+    uint8_t pied[TAILLE_PIED];
+    fichier.seekg(taille - TAILLE_PIED);
+    if (!fichier.read((char*)pied, TAILLE_PIED) || memcmp(pied + 16, MAGIC_INDEX, 4) != 0) return false;
+    uint64_t position = lireFixe<uint64_t>(pied);
+    uint64_t nombre = lireFixe<uint64_t>(pied + 8);
+    if (position < TAILLE_ENTETE || position + nombre * TAILLE_ENTREE_INDEX + TAILLE_PIED != taille) return false;
+
+    tampon.resize(nombre * TAILLE_ENTREE_INDEX);
+    fichier.seekg(position);
+    if (!fichier.read((char*)tampon.data(), tampon.size())) return false;
+    index.resize(nombre);
+    for (uint64_t i = 0; i < nombre; ++i) {
+        const uint8_t* entree = tampon.data() + i * TAILLE_ENTREE_INDEX;
+        index[i] = {lireFixe<int64_t>(entree), lireFixe<uint64_t>(entree + 8), entree[16]};
+    }
+    return true;
+}
+
+// Archive interrompue avant sa fermeture : l'index est reconstruit à partir des en-têtes d'enregistrements
+void LecteurArchive::parcourir(uint64_t position) {
+    fichier.clear();
+    index.clear();
+    const uint64_t tailleCle = (uint64_t)nbLignes * courant.getMotsParLigne() * sizeof(uint64_t);
+    uint8_t entete[21];
+    while (true) {
+        fichier.seekg(position);
+        fichier.read((char*)entete, sizeof(entete));
+        size_t lus = (size_t)fichier.gcount();
+        fichier.clear();
+        const uint8_t* p = entete + 1;
+        const uint8_t* fin = entete + lus;
+        uint64_t generation, longueur;
+        if (lus < 3 || entete[0] > ENREGISTREMENT_DELTA || !lireVarint(p, fin, generation) || !lireVarint(p, fin, longueur)) break;
+        // Les générations sont croissantes et une image clé a une taille fixe : sinon ce n'est plus un enregistrement
+        if (!index.empty() && (long long)generation <= index.back().generation) break;
+        if (entete[0] == ENREGISTREMENT_CLE && longueur != tailleCle) break;
+        uint64_t suivante = position + (p - entete) + longueur;
+        fichier.seekg(0, ios::end);
+        if (suivante > (uint64_t)fichier.tellg()) break; // Dernier enregistrement incomplet
+        index.push_back({(long long)generation, position, entete[0]});
+        position = suivante;
+    }
+}
+
+void LecteurArchive::appliquer(size_t indice) {
+    uint8_t entete[21];
+    fichier.clear();
+    fichier.seekg(index[indice].position);
+    fichier.read((char*)entete, sizeof(entete));
+    fichier.clear();
+    const uint8_t* p = entete + 1;
+    const uint8_t* fin = entete + sizeof(entete);
+    uint64_t generation, longueur;
+    lireVarint(p, fin, generation);
+    lireVarint(p, fin, longueur);
+    tampon.resize(longueur);
+    fichier.seekg(index[indice].position + (p - entete));
+    if (!fichier.read((char*)tampon.data(), longueur)) {
+        cerr << "Erreur : archive tronquee a la generation " << index[indice].generation << endl;
+        exit(1);
+    }
+
+    const int mots = courant.getMotsParLigne();
+    if (index[indice].type == ENREGISTREMENT_CLE) {
+        for (int i = 0; i < nbLignes; ++i) {
+            memcpy(courant.ligne(i), tampon.data() + (size_t)i * mots * sizeof(uint64_t), mots * sizeof(uint64_t));
+        }
+    } else {
+        const uint8_t* q = tampon.data();
+        const uint8_t* finDelta = q + tampon.size();
+        uint64_t nombre = 0, position = 0, ecart = 0;
+        lireVarint(q, finDelta, nombre);
+        for (uint64_t n = 0; n < nombre && lireVarint(q, finDelta, ecart); ++n) {
+            position += ecart;
+            int x = (int)(position / nbColonnes), y = (int)(position % nbColonnes);
+            courant.set(x, y, !courant.get(x, y)); // La cellule a basculé
+        }
+    }
+    indiceCourant = (long long)indice;
+}
+
+bool LecteurArchive::lire(long long generation, GrilleBits& etat) {
+    auto it = lower_bound(index.begin(), index.end(), generation,
+                          [](const EntreeIndex& entree, long long g) { return entree.generation < g; });
+    if (it == index.end() || it->generation != generation) return false;
+    size_t cible = it - index.begin();
+
+    // Image clé la plus proche, sauf si la génération déjà reconstruite est plus proche
+    size_t debut = cible;
+    while (debut > 0 && index[debut].type != ENREGISTREMENT_CLE) --debut;
+    if (indiceCourant >= (long long)debut && indiceCourant <= (long long)cible) debut = indiceCourant + 1;
+    for (size_t i = debut; i <= cible; ++i) appliquer(i);
+
+    etat = courant;
+    return true;
+}
+
+const vector<EntreeIndex>& LecteurArchive::getIndex() const { return index; }
+int LecteurArchive::getNbLignes() const { return nbLignes; }
+int LecteurArchive::getNbColonnes() const { return nbColonnes; }
@@ -0,0 +1,33 @@
+#ifndef LECTEURARCHIVE_H
+#define LECTEURARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include "ArchiveRun.h"
+#include "GrilleBits.h"
+
+// Lecture d'une archive de simulation : l'index donne l'image clé la plus proche de la génération
+// demandée, puis seuls les deltas qui la séparent de cette génération sont appliqués.
+class LecteurArchive {
+private:
+    std::ifstream fichier;
+    int nbLignes, nbColonnes;
+    std::vector<EntreeIndex> index;
+    GrilleBits courant;          // Dernière génération reconstruite
+    long long indiceCourant;     // Son entrée dans l'index (-1 = aucune)
+    std::vector<uint8_t> tampon;
+
+    bool lireIndex(uint64_t taille);
+    void parcourir(uint64_t position);  // Reconstruit l'index d'une archive interrompue
+    void appliquer(std::size_t indice); // Lit l'enregistrement et l'applique à courant
+
+public:
+    LecteurArchive(const std::string& chemin);
+    bool lire(long long generation, GrilleBits& etat); // Faux si la génération n'est pas dans l'archive
+    const std::vector<EntreeIndex>& getIndex() const;
+    int getNbLignes() const;
+    int getNbColonnes() const;
+};
+
+#endif // LECTEURARCHIVE_H
@@ -0,0 +1,44 @@
+#include "Mesures.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <sys/resource.h>
+
+static std::atomic<long long> compteurAllocations(0);
+
+long long nombreAllocations() { return compteurAllocations.load(std::memory_order_relaxed); }
+
+long long memoireMaxKo() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss; // En ko sous Linux
+}
+
+// Toutes les formes de new passent par ces deux fonctions
+static void* allouer(std::size_t taille) {
+    compteurAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(taille ? taille : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+static void* allouerAligne(std::size_t taille, std::align_val_t alignement) {
+    compteurAllocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t a = static_cast<std::size_t>(alignement);
+    void* p = std::aligned_alloc(a, (taille + a - 1) / a * a);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t taille) { return allouer(taille); }
+void* operator new[](std::size_t taille) { return allouer(taille); }
+void* operator new(std::size_t taille, std::align_val_t alignement) { return allouerAligne(taille, alignement); }
+void* operator new[](std::size_t taille, std::align_val_t alignement) { return allouerAligne(taille, alignement); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
@@ -0,0 +1,10 @@
+#ifndef MESURES_H
+#define MESURES_H
+
+// Mesures de ressources pour le banc d'essai et l'instrumentation.
+// Mesures.cpp remplace l'opérateur new global pour compter les allocations : il n'est lié qu'aux programmes
+// qui appellent ces fonctions (le banc d'essai, ou l'application compilée avec JDV_INSTRUMENTATION).
+long long nombreAllocations(); // Allocations faites depuis le début du programme
+long long memoireMaxKo();      // Pic de mémoire résidente du processus, en ko
+
+#endif // MESURES_H
@@ -0,0 +1,65 @@
+#include "Moteur.h"
+#include "MoteurCreux.h"
+#include "MoteurDense.h"
+#include "MoteurHashlife.h"
+#include "MoteurHybride.h"
+#include "MoteurParallele.h"
+#include "MoteurPlan.h"
+#include "MoteurTable.h"
+#include "Empreinte.h"
+
+void Moteur::avancer(long long n) {
+    for (long long i = 0; i < n; ++i) etape();
+}
+
+void Moteur::statistiques(StatistiquesGeneration& stats) const {
+    stats = StatistiquesGeneration();
+    stats.population = population();
+    std::vector<uint64_t> cles;
+    cellulesChangees(cles);
+    for (uint64_t cle : cles) {
+        if (estVivante(ligneCle(cle), colonneCle(cle))) stats.naissances++;
+        else stats.morts++;
+    }
+    GrilleBits etat;
+    exporter(etat);
+    bool trouvee = false; // Au moins une cellule vivante
+    for (int i = 0; i < etat.getNbLignes(); ++i) {
+        const uint64_t* ligne = etat.ligne(i);
+        for (int k = 0; k < etat.getMotsParLigne(); ++k) {
+            if (!ligne[k]) continue;
+            if (!trouvee) stats.ligneMin = i;
+            stats.ligneMax = i;
+            int premiere = 64 * k + __builtin_ctzll(ligne[k]), derniere = 64 * k + 63 - __builtin_clzll(ligne[k]);
+            if (!trouvee || premiere < stats.colonneMin) stats.colonneMin = premiere;
+            if (!trouvee || derniere > stats.colonneMax) stats.colonneMax = derniere;
+            trouvee = true;
+        }
+    }
+}
+
+// Fabrique des moteurs
+std::unique_ptr<Moteur> creerMoteur(TypeMoteur type, int nbThreads) {
+    switch (type) {
+        case TypeMoteur::Dense: return std::make_unique<MoteurDense>();
+        case TypeMoteur::Hashlife: return std::make_unique<MoteurHashlife>();
+        case TypeMoteur::Parallele: return std::make_unique<MoteurParallele>(nbThreads);
+        case TypeMoteur::Plan: return std::make_unique<MoteurPlan>();
+        case TypeMoteur::Table: return std::make_unique<MoteurTable>();
+        case TypeMoteur::Hybride: return std::make_unique<MoteurHybride>();
+        case TypeMoteur::Creux:
+        default: return std::make_unique<MoteurCreux>();
+    }
+}
+
+bool lireTypeMoteur(const std::string& nom, TypeMoteur& type) {
+    if (nom == "creux") type = TypeMoteur::Creux;
+    else if (nom == "dense") type = TypeMoteur::Dense;
+    else if (nom == "hashlife") type = TypeMoteur::Hashlife;
+    else if (nom == "parallele") type = TypeMoteur::Parallele;
+    else if (nom == "plan") type = TypeMoteur::Plan;
+    else if (nom == "table") type = TypeMoteur::Table;
+    else if (nom == "hybride") type = TypeMoteur::Hybride;
+    else return false;
+    return true;
+}
@@ -0,0 +1,50 @@
+#ifndef MOTEUR_H
+#define MOTEUR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "GrilleBits.h"
+#include "RegleVie.h"
+
+// Moteurs de calcul disponibles
+enum class TypeMoteur { Creux, Dense, Hashlife, Parallele, Plan, Table, Hybride };
+
+// Statistiques de la génération courante
+struct StatistiquesGeneration {
+    long long population = 0;
+    long long naissances = 0, morts = 0;  // Depuis la génération précédente
+    long long tuilesModifiees = -1;       // Tuiles modifiées par la dernière étape (-1 : moteur sans tuiles)
+    int ligneMin = 0, ligneMax = -1;      // Boîte englobante des cellules vivantes (vide si ligneMax < ligneMin)
+    int colonneMin = 0, colonneMax = -1;
+};
+
+// Interface commune des moteurs de calcul du jeu de la vie (grille torique, ou plan infini pour MoteurPlan)
+class Moteur {
+protected:
+    RegleVie regle; // B3/S23 par défaut
+
+public:
+    virtual ~Moteur() = default;
+    virtual void setRegle(const RegleVie& nouvelle) { regle = nouvelle; } // À appeler de préférence avant charger
+    const RegleVie& getRegle() const { return regle; }
+    virtual void charger(const GrilleBits& etat) = 0;   // Initialise le moteur avec une configuration
+    virtual void etape() = 0;                           // Calcule la génération suivante
+    virtual void avancer(long long n);                  // Avance de n générations (par défaut n étapes)
+    virtual void exporter(GrilleBits& etat) const = 0;  // Copie la génération courante
+    virtual void cellulesChangees(std::vector<uint64_t>& cles) const = 0; // Cellules basculées lors de la dernière étape (voir cleCellule)
+    virtual bool estVivante(int x, int y) const = 0;
+    virtual long long population() const = 0;
+    virtual long long tuilesCalculees() const { return -1; } // Tuiles recalculées depuis charger (-1 : moteur sans tuiles)
+    virtual void suivreStatistiques(bool) {} // Les moteurs qui le peuvent tiennent leurs statistiques à jour pendant l'étape
+    virtual void setProfondeur(int) {}       // Blocage temporel d'avancer : générations par passage en cache (1 = aucun)
+    virtual long long octetsGrilleEstimes() const { return -1; } // Estimation (tuiles et blocs calculés, pas un trafic mesuré) des octets de grille lus et écrits depuis charger ; -1 : aucune
+    virtual void statistiques(StatistiquesGeneration& stats) const; // Par défaut : changements, population et export de la grille
+    virtual std::string nom() const = 0;
+};
+
+std::unique_ptr<Moteur> creerMoteur(TypeMoteur type, int nbThreads = 0); // nbThreads : moteur parallèle uniquement (0 = défaut)
+bool lireTypeMoteur(const std::string& nom, TypeMoteur& type); // Retourne false si le nom est inconnu
+
+#endif // MOTEUR_H
@@ -0,0 +1,162 @@
+#include "MoteurCreux.h"
+#include "Empreinte.h"
+#include "Instrumentation.h"
+#include <algorithm>
+
+using namespace std;
+
+MoteurCreux::MoteurCreux() : nbLignes(0), nbColonnes(0), decalageTable(64) {}
+
+void MoteurCreux::charger(const GrilleBits& etat) {
+    nbLignes = etat.getNbLignes();
+    nbColonnes = etat.getNbColonnes();
+    grille = etat;
+    cellulesVivantes.clear();
+    for (int i = 0; i < nbLignes; ++i) {
+        const uint64_t* ligne = etat.ligne(i);
+        for (int k = 0; k < etat.getMotsParLigne(); ++k) {
+            for (uint64_t mot = ligne[k]; mot; mot &= mot - 1) { // Bits à 1 du mot, dans l'ordre des colonnes
+                cellulesVivantes.push_back(cleCellule(i, 64 * k + __builtin_ctzll(mot)));
+            }
+        }
+    }
+    anciennesCellulesVivantes = cellulesVivantes; // Aucun changement avant la première étape
+
+    // Listes dimensionnées d'avance : la population peut doubler sans nouvelle allocation
+    const size_t capacite = std::max<size_t>(2 * cellulesVivantes.size(), 1024);
+    cellulesVivantes.reserve(capacite);
+    anciennesCellulesVivantes.reserve(capacite);
+    nouvellesCellulesVivantes.reserve(capacite);
+    dimensionnerTable(std::max<size_t>(cellulesVivantes.size(), 1024));
+}
+
+void MoteurCreux::dimensionnerTable(size_t cellules) {
+    size_t taille = 1;
+    int bits = 0;
+    while (taille < 2 * 9 * cellules) { // Chaque cellule vivante notifie au plus 9 cases (8 voisines, règles S0)
+        taille *= 2;
+        bits++;
+    }
+    if (taille <= clesTable.size()) return; // La table ne rétrécit jamais
+    clesTable.assign(taille, CASE_VIDE);
+    voisinsTable.assign(taille, 0);
+    casesOccupees.reserve(taille / 2);
+    decalageTable = 64 - bits;
+}
+
+// Hachage multiplicatif puis sondage linéaire
+uint32_t MoteurCreux::chercherCase(uint64_t cle) const {
+    const uint32_t masque = (uint32_t)(clesTable.size() - 1);
+    uint32_t c = (uint32_t)((cle * 0x9E3779B97F4A7C15ULL) >> decalageTable) & masque;
+    while (clesTable[c] != cle && clesTable[c] != CASE_VIDE) c = (c + 1) & masque;
+    return c;
+}
+
+void MoteurCreux::notifierVoisines(uint64_t cle) {
+        const int x = ligneCle(cle), y = colonneCle(cle);
+        const int lignes[3] = {x == 0 ? nbLignes - 1 : x - 1, x, x == nbLignes - 1 ? 0 : x + 1}; // Gestion du tore
+        const int colonnes[3] = {y == 0 ? nbColonnes - 1 : y - 1, y, y == nbColonnes - 1 ? 0 : y + 1};
+        for (int dx = 0; dx < 3; ++dx) {       // Parcourt les 8 voisins potentiels (y compris diagonales)
+            for (int dy = 0; dy < 3; ++dy) {
+                if (dx == 1 && dy == 1) continue; // Ignore la cellule elle-même
+
+                const uint64_t voisine = cleCellule(lignes[dx], colonnes[dy]);
+                const uint32_t c = chercherCase(voisine);
+                if (clesTable[c] == CASE_VIDE) {
+                    clesTable[c] = voisine;
+                    voisinsTable[c] = 0;
+                    casesOccupees.push_back(c);
+                }
+                voisinsTable[c]++; // Incrémente le nombre de voisins pour cette position
+            }
+        }
+    }
+
+void MoteurCreux::etape() {
+        dimensionnerTable(cellulesVivantes.size());
+
+        // Parcourt les cellules vivantes pour notifier le nombre de voisines à leurs voisines
+        {
+            MESURER_PHASE(Phase::Notification);
+            for (uint64_t cle : cellulesVivantes) {
+                notifierVoisines(cle);
+            }
+        }
+        COMPTER(Compteur::CellulesCandidates, casesOccupees.size());
+
+        nouvellesCellulesVivantes.clear(); // Garde sa capacité
+        {
+            MESURER_PHASE(Phase::Regle);
+
+            // Applique les règles du jeu aux cellules ayant des voisins
+            for (uint32_t c : casesOccupees) {
+                const uint64_t cle = clesTable[c];
+                bool estVivante = grille.get(ligneCle(cle), colonneCle(cle));
+                if (regle.application(estVivante, voisinsTable[c])) {
+                    nouvellesCellulesVivantes.push_back(cle); // Ajoute les cellules qui deviennent vivantes
+                }
+            }
+
+            // Règles avec survie à 0 voisine (S0) : les cellules isolées n'ont pas été notifiées
+            if (regle.survie & 1) {
+                for (uint64_t cle : cellulesVivantes) {
+                    if (clesTable[chercherCase(cle)] == CASE_VIDE) nouvellesCellulesVivantes.push_back(cle);
+                }
+            }
+            std::sort(nouvellesCellulesVivantes.begin(), nouvellesCellulesVivantes.end()); // Tri en place
+        }
+
+        // Met à jour la grille avec les nouvelles cellules vivantes
+        MESURER_PHASE(Phase::Reconstruction);
+        for (uint32_t c : casesOccupees) clesTable[c] = CASE_VIDE; // Vide la table pour l'étape suivante
+        casesOccupees.clear();
+        for (uint64_t cle : cellulesVivantes) grille.set(ligneCle(cle), colonneCle(cle), false);
+        for (uint64_t cle : nouvellesCellulesVivantes) grille.set(ligneCle(cle), colonneCle(cle), true); // Active les cellules vivantes
+        anciennesCellulesVivantes.swap(cellulesVivantes); // Garde la génération précédente pour cellulesChangees
+        cellulesVivantes.swap(nouvellesCellulesVivantes); // Met à jour la liste des cellules vivantes sans copie
+}
+
+void MoteurCreux::exporter(GrilleBits& etat) const { etat = grille; }
+
+// Différence symétrique des deux listes triées : cellules nées ou mortes
+void MoteurCreux::cellulesChangees(std::vector<uint64_t>& cles) const {
+    cles.clear();
+    auto a = anciennesCellulesVivantes.begin(), b = cellulesVivantes.begin();
+    while (a != anciennesCellulesVivantes.end() || b != cellulesVivantes.end()) {
+        if (b == cellulesVivantes.end() || (a != anciennesCellulesVivantes.end() && *a < *b)) {
+            cles.push_back(*a); ++a;
+        } else if (a == anciennesCellulesVivantes.end() || *b < *a) {
+            cles.push_back(*b); ++b;
+        } else {
+            ++a; ++b;
+        }
+    }
+}
+
+// Naissances et morts par la même différence symétrique ; les lignes extrêmes sont aux bouts de la liste triée
+void MoteurCreux::statistiques(StatistiquesGeneration& stats) const {
+    stats = StatistiquesGeneration();
+    stats.population = (long long)cellulesVivantes.size();
+    auto a = anciennesCellulesVivantes.begin(), b = cellulesVivantes.begin();
+    while (a != anciennesCellulesVivantes.end() || b != cellulesVivantes.end()) {
+        if (b == cellulesVivantes.end() || (a != anciennesCellulesVivantes.end() && *a < *b)) {
+            stats.morts++; ++a;
+        } else if (a == anciennesCellulesVivantes.end() || *b < *a) {
+            stats.naissances++; ++b;
+        } else {
+            ++a; ++b;
+        }
+    }
+    if (cellulesVivantes.empty()) return;
+    stats.ligneMin = ligneCle(cellulesVivantes.front());
+    stats.ligneMax = ligneCle(cellulesVivantes.back());
+    stats.colonneMin = nbColonnes;
+    for (uint64_t cle : cellulesVivantes) {
+        stats.colonneMin = min(stats.colonneMin, colonneCle(cle));
+        stats.colonneMax = max(stats.colonneMax, colonneCle(cle));
+    }
+}
+
+bool MoteurCreux::estVivante(int x, int y) const { return grille.get(x, y); }
+long long MoteurCreux::population() const { return (long long)cellulesVivantes.size(); }
+std::string MoteurCreux::nom() const { return "creux"; }
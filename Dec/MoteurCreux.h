@@ -0,0 +1,43 @@
+#ifndef MOTEURCREUX_H
+#define MOTEURCREUX_H
+
+#include <vector>
+#include <cstdint>
+#include "Moteur.h"
+#include "GrilleBits.h"
+
+// Moteur historique : liste des cellules vivantes et comptage des voisins par notification.
+// Cellules repérées par leur clé cleCellule (ligne et colonne dans un entier de 64 bits), listes triées
+// et table de comptage à adressage ouvert : tous les tampons sont réutilisés d'une étape à l'autre,
+// une fois la population maximale atteinte une génération ne fait plus aucune allocation.
+class MoteurCreux : public Moteur {
+private:
+    static constexpr uint64_t CASE_VIDE = ~0ULL; // Aucune clé de cellule n'a cette valeur
+
+    int nbLignes, nbColonnes;
+    GrilleBits grille;                                // État des cellules (estVivante, règle)
+    std::vector<uint64_t> cellulesVivantes;           // Clés triées : ordre des lignes puis des colonnes
+    std::vector<uint64_t> anciennesCellulesVivantes;  // Cellules vivantes de la génération précédente
+    std::vector<uint64_t> nouvellesCellulesVivantes;  // Tampon de l'étape (échangé, jamais copié)
+    std::vector<uint64_t> clesTable;                  // Table des cellules notifiées (CASE_VIDE si libre)
+    std::vector<uint8_t> voisinsTable;                // Nombre de voisines vivantes de chaque case
+    std::vector<uint32_t> casesOccupees;              // Cases remplies pendant l'étape, vidées à la fin
+    int decalageTable;                                // 64 - log2(taille de la table)
+
+    void dimensionnerTable(std::size_t cellules); // Agrandit la table si besoin (taux de remplissage <= 1/2)
+    uint32_t chercherCase(uint64_t cle) const;     // Case de la clé, ou case libre où l'insérer
+    void notifierVoisines(uint64_t cle);
+
+public:
+    MoteurCreux();
+    void charger(const GrilleBits& etat) override;
+    void etape() override;
+    void exporter(GrilleBits& etat) const override;
+    void cellulesChangees(std::vector<uint64_t>& cles) const override;
+    bool estVivante(int x, int y) const override;
+    long long population() const override;
+    void statistiques(StatistiquesGeneration& stats) const override;
+    std::string nom() const override;
+};
+
+#endif // MOTEURCREUX_H
@@ -0,0 +1,345 @@
+#include "MoteurDense.h"
+#include "NoyauDense.h"
+#include "Empreinte.h"
+#include <utility>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Tuiles voisines d'une bande : OU de la tuile et de ses voisines de gauche et de droite (le tore relie la dernière à la première)
+void dilater(const uint64_t* bande, uint64_t* sortie, int mots, int nbTuiles) {
+    const int reste = nbTuiles - 64 * (mots - 1);
+    for (int k = 0; k < mots; ++k) {
+        uint64_t ouest = (bande[k] << 1) | (k > 0 ? bande[k - 1] >> 63 : (bande[mots - 1] >> (reste - 1)) & 1);
+        uint64_t est = (bande[k] >> 1) | (k < mots - 1 ? bande[k + 1] << 63 : (bande[0] & 1) << (reste - 1));
+        sortie[k] |= bande[k] | ouest | est;
+    }
+    sortie[mots - 1] &= reste >= 64 ? ~0ULL : (1ULL << reste) - 1;
+}
+
+// Première tuile d'indice >= depuis dont le bit vaut valeur (nbTuiles si aucune)
+int chercher(const uint64_t* bande, int depuis, bool valeur, int nbTuiles) {
+    for (int m = depuis / 64; 64 * m < nbTuiles; ++m) {
+        uint64_t mot = (valeur ? bande[m] : ~bande[m]) & (~0ULL << (m == depuis / 64 ? depuis % 64 : 0));
+        if (mot) return std::min(64 * m + __builtin_ctzll(mot), nbTuiles);
+    }
+    return nbTuiles;
+}
+
+} // namespace
+
+MoteurDense::MoteurDense()
+    : noyau(choisirNoyau(regle)), compteur(choisirCompteur()), nbBandes(0), motsBandes(0), totalTuiles(0), suiviStatistiques(false), populationSuivie(0), profondeur(1), octets(0) {}
+
+MoteurDense::BilanEtape& MoteurDense::BilanEtape::operator+=(const BilanEtape& autre) {
+    tuilesCalculees += autre.tuilesCalculees;
+    tuilesModifiees += autre.tuilesModifiees;
+    naissances += autre.naissances;
+    morts += autre.morts;
+    return *this;
+}
+
+void MoteurDense::setRegle(const RegleVie& nouvelle) {
+    regle = nouvelle;
+    noyau = choisirNoyau(regle);
+    toutActiver(); // Une configuration stable pour l'ancienne règle ne l'est plus forcément
+}
+
+void MoteurDense::toutActiver() {
+    const int tuiles = courant.getMotsParLigne();
+    for (int b = 0; b < nbBandes; ++b) {
+        uint64_t* bande = &changees[(size_t)b * motsBandes];
+        for (int k = 0; k < motsBandes; ++k) bande[k] = ~0ULL;
+        bande[motsBandes - 1] &= tuiles % 64 == 0 ? ~0ULL : (1ULL << (tuiles % 64)) - 1;
+    }
+}
+
+void MoteurDense::charger(const GrilleBits& etat) {
+    courant = etat;
+    suivant = etat; // Aucun changement avant la première étape
+    nbBandes = (etat.getNbLignes() + HAUTEUR_TUILE - 1) / HAUTEUR_TUILE;
+    motsBandes = (etat.getMotsParLigne() + 63) / 64;
+    changees.assign((size_t)nbBandes * motsBandes, 0);
+    prochaines.assign(changees.size(), 0);
+    voisinage.assign(changees.size(), 0);
+    totalTuiles = 0;
+    octets = 0;
+    toutActiver();
+    if (suiviStatistiques) initialiserStatistiques();
+}
+
+void MoteurDense::suivreStatistiques(bool actif) {
+    suiviStatistiques = actif;
+    if (actif) initialiserStatistiques();
+}
+
+void MoteurDense::initialiserStatistiques() {
+    const int mots = courant.getMotsParLigne();
+    populationTuiles.assign((size_t)nbBandes * mots, 0);
+    occupees.assign(changees.size(), 0);
+    populationSuivie = 0;
+    dernierBilan = BilanEtape();
+    for (int x = 0; x < courant.getNbLignes(); ++x) {
+        const int b = x / HAUTEUR_TUILE;
+        for (int k = 0; k < mots; ++k) {
+            const int vivantes = __builtin_popcountll(courant.ligne(x)[k]);
+            populationTuiles[(size_t)b * mots + k] += vivantes;
+            populationSuivie += vivantes;
+            if (vivantes) occupees[(size_t)b * motsBandes + k / 64] |= 1ULL << (k % 64);
+        }
+    }
+}
+
+void MoteurDense::calculerBandes(int debut, int fin, BilanEtape& bilan) {
+    const int mots = courant.getMotsParLigne();
+
+    for (int b = debut; b < fin; ++b) {
+        // Tuiles à recalculer : modifiées à l'étape précédente ou voisines d'une tuile modifiée
+        uint64_t* actives = &voisinage[(size_t)b * motsBandes];
+        std::fill(actives, actives + motsBandes, 0);
+        for (int db = -1; db <= 1; ++db) {
+            dilater(&changees[(size_t)((b + db + nbBandes) % nbBandes) * motsBandes], actives, motsBandes, mots);
+        }
+        uint64_t* modifiees = &prochaines[(size_t)b * motsBandes];
+        std::fill(modifiees, modifiees + motsBandes, 0);
+        calculerBande(b, actives, modifiees, bilan);
+    }
+}
+
+void MoteurDense::calculerBande(int b, uint64_t* actives, uint64_t* modifiees, BilanEtape& bilan) {
+    const int nbLignes = courant.getNbLignes();
+    const int mots = courant.getMotsParLigne();
+    const int premiere = b * HAUTEUR_TUILE, derniere = std::min(premiere + HAUTEUR_TUILE, nbLignes);
+
+    // Tuiles actives consécutives : un seul appel du noyau par ligne
+    for (int k = chercher(actives, 0, true, mots); k < mots; ) {
+        const int finSerie = chercher(actives, k, false, mots);
+
+        for (int x = premiere; x < derniere; ++x) {
+            const uint64_t* haut = courant.ligne((x - 1 + nbLignes) % nbLignes); // Lignes voisines avec gestion du tore
+            const uint64_t* bas = courant.ligne((x + 1) % nbLignes);
+            noyau(haut, courant.ligne(x), bas, suivant.ligne(x), courant.getNbColonnes(), mots, k, finSerie, regle);
+        }
+        if (suiviStatistiques) {
+            // Tuiles comptées par groupes de 64, ligne par ligne pendant que la bande est en cache
+            for (int j = k; j < finSerie; j += 64) {
+                const int nb = std::min(64, finSerie - j);
+                uint64_t differences[64], naissances[64], morts[64];
+                std::fill_n(differences, nb, 0);
+                std::fill_n(naissances, nb, 0);
+                std::fill_n(morts, nb, 0);
+                compteur(courant.ligne(premiere) + j, suivant.ligne(premiere) + j, mots, derniere - premiere, nb,
+                         differences, naissances, morts);
+                for (int t = 0; t < nb; ++t) {
+                    if (!differences[t]) continue;
+                    modifiees[(j + t) / 64] |= 1ULL << ((j + t) % 64);
+                    bilan.tuilesModifiees++;
+                    uint32_t& vivantes = populationTuiles[(size_t)b * mots + j + t];
+                    vivantes += naissances[t] - morts[t];
+                    uint64_t& occupation = occupees[(size_t)b * motsBandes + (j + t) / 64];
+                    occupation = vivantes ? occupation | (1ULL << ((j + t) % 64)) : occupation & ~(1ULL << ((j + t) % 64));
+                    bilan.naissances += naissances[t];
+                    bilan.morts += morts[t];
+                }
+            }
+        } else {
+            for (int j = k; j < finSerie; ++j) {
+                uint64_t difference = 0;
+                for (int x = premiere; x < derniere; ++x) difference |= courant.ligne(x)[j] ^ suivant.ligne(x)[j];
+                if (!difference) continue;
+                modifiees[j / 64] |= 1ULL << (j % 64);
+                bilan.tuilesModifiees++;
+            }
+        }
+        bilan.tuilesCalculees += finSerie - k;
+        k = chercher(actives, finSerie, true, mots);
+    }
+}
+
+void MoteurDense::terminerEtape(const BilanEtape& bilan) {
+    totalTuiles += bilan.tuilesCalculees;
+    octets += bilan.tuilesCalculees * HAUTEUR_TUILE * 2 * (long long)sizeof(uint64_t); // Tuile lue puis écrite
+    dernierBilan = bilan;
+    populationSuivie += bilan.naissances - bilan.morts;
+    std::swap(courant, suivant); // Échange des tampons : aucune copie
+    std::swap(changees, prochaines);
+}
+
+void MoteurDense::etape() {
+    BilanEtape bilan;
+    calculerBandes(0, nbBandes, bilan);
+    terminerEtape(bilan);
+}
+
+void MoteurDense::setProfondeur(int k) { profondeur = std::max(1, std::min(k, PROFONDEUR_MAX)); }
+
+bool MoteurDense::lignesEntieres() const {
+    return courant.getNbColonnes() % 64 != 0 || courant.getMotsParLigne() <= MOTS_BLOC + 2;
+}
+
+int MoteurDense::nombreBlocs() const {
+    const int blocsMots = lignesEntieres() ? 1 : (courant.getMotsParLigne() + MOTS_BLOC - 1) / MOTS_BLOC;
+    return (courant.getNbLignes() + LIGNES_BLOC - 1) / LIGNES_BLOC * blocsMots;
+}
+
+// Le tore est déplié : les lignes et les mots du halo sont lus modulo les dimensions de la grille. Les mots
+// du bord de la zone sont faux dès la première génération (le noyau les relie entre eux), mais l'erreur
+// n'avance que d'une cellule par génération et reste dans le mot de halo ; de même pour les lignes.
+long long MoteurDense::passerBlocs(int debut, int fin, int generations, ZoneBloc& zone) {
+    const int nbLignes = courant.getNbLignes(), mots = courant.getMotsParLigne();
+    const bool entieres = lignesEntieres();
+    const int blocsMots = entieres ? 1 : (mots + MOTS_BLOC - 1) / MOTS_BLOC;
+    const int halo = entieres ? 0 : 1; // Mots de halo de chaque côté
+    long long transferes = 0;
+
+    for (int bloc = debut; bloc < fin; ++bloc) {
+        const int premiereLigne = bloc / blocsMots * LIGNES_BLOC, premierMot = bloc % blocsMots * MOTS_BLOC;
+        const int hauteur = std::min(LIGNES_BLOC, nbLignes - premiereLigne);
+        const int largeur = entieres ? mots : std::min(MOTS_BLOC, mots - premierMot);
+        const int lignes = hauteur + 2 * generations, motsZone = largeur + 2 * halo;
+        zone.lue.resize((size_t)lignes * motsZone);
+        zone.calculee.resize(zone.lue.size());
+        uint64_t* lue = zone.lue.data();
+        uint64_t* calculee = zone.calculee.data();
+
+        for (int i = 0; i < lignes; ++i) {
+            const uint64_t* source = courant.ligne(((premiereLigne - generations + i) % nbLignes + nbLignes) % nbLignes);
+            uint64_t* cible = lue + (size_t)i * motsZone;
+            if (entieres) memcpy(cible, source, (size_t)mots * sizeof(uint64_t));
+            else for (int j = 0; j < motsZone; ++j) cible[j] = source[(premierMot - 1 + j + mots) % mots];
+        }
+        transferes += (long long)lignes * motsZone * sizeof(uint64_t);
+
+        // Génération t : lignes [t, lignes - t), le halo perd une ligne de chaque côté
+        const int colonnesZone = entieres ? courant.getNbColonnes() : 64 * motsZone;
+        for (int t = 1; t <= generations; ++t) {
+            for (int i = t; i < lignes - t; ++i) {
+                const size_t ligne = (size_t)i * motsZone;
+                noyau(lue + ligne - motsZone, lue + ligne, lue + ligne + motsZone, calculee + ligne, colonnesZone, motsZone, 0,
+                      motsZone, regle);
+            }
+            std::swap(lue, calculee);
+        }
+
+        for (int i = 0; i < hauteur; ++i) {
+            memcpy(suivant.ligne(premiereLigne + i) + premierMot, lue + (size_t)(generations + i) * motsZone + halo,
+                   (size_t)largeur * sizeof(uint64_t));
+        }
+        transferes += (long long)hauteur * largeur * sizeof(uint64_t);
+    }
+    return transferes;
+}
+
+void MoteurDense::avancerBlocs(int generations) {
+    if (zones.empty()) zones.resize(1);
+    octets += passerBlocs(0, nombreBlocs(), generations, zones[0]);
+    std::swap(courant, suivant);
+}
+
+// La dernière génération est une étape ordinaire : cellulesChangees, les statistiques et le suivi des tuiles
+// modifiées restent exacts
+void MoteurDense::avancer(long long n) {
+    if (profondeur <= 1 || n < 2) {
+        Moteur::avancer(n);
+        return;
+    }
+    for (long long restantes = n - 1; restantes > 0; ) {
+        const int generations = (int)std::min<long long>(profondeur, restantes);
+        avancerBlocs(generations);
+        totalTuiles += generations * nombreTuiles();
+        restantes -= generations;
+    }
+    toutActiver();
+    if (suiviStatistiques) initialiserStatistiques();
+    etape();
+}
+
+void MoteurDense::exporter(GrilleBits& etat) const { etat = courant; }
+
+// Après l'échange, le tampon suivant contient la génération précédente : les changements sont son OU exclusif
+// avec la courante, dans les seules tuiles modifiées
+void MoteurDense::listerChangements(int debut, int fin, std::vector<uint64_t>& cles) const {
+    const int nbLignes = courant.getNbLignes();
+    for (int b = debut; b < fin; ++b) {
+        const uint64_t* modifiees = &changees[(size_t)b * motsBandes];
+        bool aucune = true;
+        for (int m = 0; m < motsBandes; ++m) aucune = aucune && !modifiees[m];
+        if (aucune) continue;
+        for (int i = b * HAUTEUR_TUILE; i < std::min((b + 1) * HAUTEUR_TUILE, nbLignes); ++i) {
+            const uint64_t* a = courant.ligne(i);
+            const uint64_t* p = suivant.ligne(i);
+            for (int m = 0; m < motsBandes; ++m) {
+                for (uint64_t tuiles = modifiees[m]; tuiles; tuiles &= tuiles - 1) {
+                    const int k = 64 * m + __builtin_ctzll(tuiles);
+                    for (uint64_t diff = a[k] ^ p[k]; diff; diff &= diff - 1) {
+                        cles.push_back(cleCellule(i, 64 * k + __builtin_ctzll(diff)));
+                    }
+                }
+            }
+        }
+    }
+}
+
+void MoteurDense::cellulesChangees(std::vector<uint64_t>& cles) const {
+    cles.clear();
+    listerChangements(0, nbBandes, cles);
+}
+
+bool MoteurDense::estVivante(int x, int y) const { return courant.get(x, y); }
+long long MoteurDense::population() const { return suiviStatistiques ? populationSuivie : courant.population(); }
+long long MoteurDense::tuilesCalculees() const { return totalTuiles; }
+long long MoteurDense::octetsGrilleEstimes() const { return octets; }
+// Boîte englobante : bandes et colonnes de tuiles occupées, puis lignes et bits exacts dans les tuiles du bord
+void MoteurDense::statistiques(StatistiquesGeneration& stats) const {
+    if (!suiviStatistiques) {
+        Moteur::statistiques(stats);
+        return;
+    }
+    stats = StatistiquesGeneration();
+    stats.population = populationSuivie;
+    stats.naissances = dernierBilan.naissances;
+    stats.morts = dernierBilan.morts;
+    stats.tuilesModifiees = dernierBilan.tuilesModifiees;
+
+    const int mots = courant.getMotsParLigne();
+    int bandeMin = -1, bandeMax = -1, tuileMin = mots, tuileMax = -1;
+    for (int b = 0; b < nbBandes; ++b) {
+        const uint64_t* bande = &occupees[(size_t)b * motsBandes];
+        const int premiere = chercher(bande, 0, true, mots);
+        if (premiere >= mots) continue;
+        if (bandeMin < 0) bandeMin = b;
+        bandeMax = b;
+        tuileMin = std::min(tuileMin, premiere);
+        for (int m = motsBandes - 1; m >= 0; --m) {
+            if (bande[m]) {
+                tuileMax = std::max(tuileMax, 64 * m + 63 - __builtin_clzll(bande[m]));
+                break;
+            }
+        }
+    }
+    if (bandeMin < 0) return; // Aucune cellule vivante
+
+    auto occupee = [&](int x) {
+        const uint64_t* ligne = courant.ligne(x);
+        for (int k = tuileMin; k <= tuileMax; ++k) {
+            if (ligne[k]) return true;
+        }
+        return false;
+    };
+    const int nbLignes = courant.getNbLignes();
+    stats.ligneMin = bandeMin * HAUTEUR_TUILE;
+    while (!occupee(stats.ligneMin)) stats.ligneMin++;
+    stats.ligneMax = std::min((bandeMax + 1) * HAUTEUR_TUILE, nbLignes) - 1;
+    while (!occupee(stats.ligneMax)) stats.ligneMax--;
+    uint64_t gauche = 0, droite = 0;
+    for (int x = stats.ligneMin; x <= stats.ligneMax; ++x) {
+        gauche |= courant.ligne(x)[tuileMin];
+        droite |= courant.ligne(x)[tuileMax];
+    }
+    stats.colonneMin = 64 * tuileMin + __builtin_ctzll(gauche);
+    stats.colonneMax = 64 * tuileMax + 63 - __builtin_clzll(droite);
+}
+
+long long MoteurDense::nombreTuiles() const { return (long long)nbBandes * courant.getMotsParLigne(); }
+std::string MoteurDense::nom() const { return "dense"; }
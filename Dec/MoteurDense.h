@@ -0,0 +1,84 @@
+#ifndef MOTEURDENSE_H
+#define MOTEURDENSE_H
+
+#include "Moteur.h"
+#include "NoyauDense.h"
+
+// Moteur dense : grille compacte en mots de 64 bits, double tampon, 64 cellules calculées à la fois.
+// La grille est découpée en tuiles de 64 lignes sur un mot : seules les tuiles qui ont changé à l'étape
+// précédente, ou dont une voisine a changé, sont recalculées. Une tuile stable est identique dans les
+// deux tampons, elle est donc reportée telle quelle sans copie.
+// Avec suivreStatistiques, les naissances et les morts sont comptées (popcount) dans les seules tuiles modifiées,
+// pendant la comparaison des deux tampons que l'étape fait déjà : population et boîte englobante en découlent.
+// Avec setProfondeur(k), avancer fait k générations par passage : chaque bloc de la grille est copié avec un
+// halo de k lignes (et d'un mot de chaque côté) dans une zone qui tient en cache, avancé de k générations,
+// et seul son intérieur, exact, est réécrit (blocs trapézoïdaux qui se recouvrent). La grille complète ne
+// traverse la mémoire qu'une fois toutes les k générations.
+class MoteurDense : public Moteur {
+protected:
+    static constexpr int HAUTEUR_TUILE = 64;
+    static constexpr int LIGNES_BLOC = 128;     // Blocage temporel : bloc de 128 lignes sur 32 mots (2048 colonnes)
+    static constexpr int MOTS_BLOC = 32;
+    static constexpr int PROFONDEUR_MAX = 64;   // Le halo d'un mot absorbe au plus 64 générations
+
+    // Bilan d'une étape sur un ensemble de bandes (sommé entre les threads du moteur parallèle)
+    struct BilanEtape {
+        long long tuilesCalculees = 0, tuilesModifiees = 0, naissances = 0, morts = 0;
+        BilanEtape& operator+=(const BilanEtape& autre);
+    };
+
+    // Bloc et son halo pendant un passage : deux générations alternées (réutilisées d'un passage à l'autre)
+    struct ZoneBloc {
+        std::vector<uint64_t> lue, calculee;
+    };
+
+    GrilleBits courant;  // Génération courante
+    GrilleBits suivant;  // Tampon de la génération suivante (échangé après chaque étape)
+    NoyauLigne noyau;    // Noyau compilé pour la règle
+    CompteurChangements compteur; // Naissances et morts d'une tuile (suivi des statistiques)
+    int nbBandes;        // Bandes de 64 lignes (la dernière peut être incomplète)
+    int motsBandes;      // Mots de 64 bits par bande dans les tables de tuiles
+    std::vector<uint64_t> changees;    // Bit k de la bande b : tuile (b, k) modifiée lors de la dernière étape
+    std::vector<uint64_t> prochaines;  // Table en cours de remplissage (échangée après chaque étape)
+    std::vector<uint64_t> voisinage;   // Tuiles à recalculer : modifiées ou voisines d'une tuile modifiée
+    long long totalTuiles; // Tuiles recalculées depuis le chargement
+    bool suiviStatistiques;
+    BilanEtape dernierBilan;
+    long long populationSuivie;
+    std::vector<uint32_t> populationTuiles; // Cellules vivantes de la tuile (b, k), indice b * mots + k
+    std::vector<uint64_t> occupees;         // Bit k de la bande b : tuile (b, k) non vide
+    int profondeur;        // Générations par passage du blocage temporel (1 = étapes ordinaires)
+    long long octets;      // Octets de courant et suivant lus et écrits depuis le chargement (estimation)
+    std::vector<ZoneBloc> zones; // Une par thread
+
+    void calculerBandes(int debut, int fin, BilanEtape& bilan); // Calcule les tuiles actives des bandes [debut, fin)
+    virtual void calculerBande(int b, uint64_t* actives, uint64_t* modifiees, BilanEtape& bilan); // Tuiles actives de la bande b
+    void terminerEtape(const BilanEtape& bilan);               // Échange les tampons et cumule le bilan
+    void initialiserStatistiques();                            // Comptage complet (chargement, activation)
+    void listerChangements(int debut, int fin, std::vector<uint64_t>& cles) const; // Ajoute les cellules basculées des bandes [debut, fin)
+    void toutActiver(); // Toutes les tuiles seront recalculées à la prochaine étape
+    bool lignesEntieres() const; // Blocs larges de toute la ligne (grille étroite, ou dernière colonne dans un mot partiel)
+    int nombreBlocs() const;
+    long long passerBlocs(int debut, int fin, int generations, ZoneBloc& zone); // Blocs [debut, fin) de courant vers suivant ; retourne les octets transférés (estimation)
+    virtual void avancerBlocs(int generations); // Un passage sur toute la grille, puis échange des tampons
+
+public:
+    MoteurDense();
+    void setRegle(const RegleVie& nouvelle) override;
+    void charger(const GrilleBits& etat) override;
+    void etape() override;
+    void avancer(long long n) override; // Par passages de profondeur générations, la dernière en étape ordinaire
+    void setProfondeur(int k) override;
+    void exporter(GrilleBits& etat) const override;
+    void cellulesChangees(std::vector<uint64_t>& cles) const override;
+    bool estVivante(int x, int y) const override;
+    long long population() const override;
+    long long tuilesCalculees() const override;
+    long long octetsGrilleEstimes() const override;
+    void suivreStatistiques(bool actif) override;
+    void statistiques(StatistiquesGeneration& stats) const override;
+    long long nombreTuiles() const;
+    std::string nom() const override;
+};
+
+#endif // MOTEURDENSE_H
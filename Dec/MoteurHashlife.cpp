@@ -0,0 +1,387 @@
+#include "MoteurHashlife.h"
+#include "NoyauDense.h"
+#include "Empreinte.h"
+#include <utility>
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+// Génération suivante d'un carré de 16x16 cellules (bits 0 à 15 de chaque ligne) sans tore :
+// la zone valide rétrécit d'une cellule sur chaque bord à chaque génération
+void etape16(uint32_t lignes[16], const RegleVie& regle) {
+    uint32_t suivantes[16] = {0};
+    for (int r = 1; r < 15; ++r) {
+        uint32_t voisins[8] = {lignes[r - 1] << 1, lignes[r - 1], lignes[r - 1] >> 1,
+                               lignes[r] << 1, lignes[r] >> 1,
+                               lignes[r + 1] << 1, lignes[r + 1], lignes[r + 1] >> 1};
+        uint32_t b0 = 0, b1 = 0, b2 = 0, b3 = 0; // Nombre de voisins en tranches de bits
+        for (uint32_t v : voisins) {
+            uint32_t r0 = b0 & v; b0 ^= v;
+            uint32_t r1 = b1 & r0; b1 ^= r0;
+            uint32_t r2 = b2 & r1; b2 ^= r1;
+            b3 |= r2;
+        }
+        suivantes[r] = appliquerRegle(regle, b0, b1, b2, b3, lignes[r]) & 0xFFFF;
+    }
+    for (int r = 0; r < 16; ++r) lignes[r] = suivantes[r];
+}
+
+} // namespace
+
+bool MoteurHashlife::CleNoeud::operator==(const CleNoeud& other) const {
+    return fils[0] == other.fils[0] && fils[1] == other.fils[1] && fils[2] == other.fils[2] && fils[3] == other.fils[3];
+}
+
+std::size_t MoteurHashlife::HachageCleNoeud::operator()(const CleNoeud& cle) const {
+    uint64_t h = cle.fils[0];
+    h = h * 0x9e3779b97f4a7c15ULL + cle.fils[1];
+    h = h * 0x9e3779b97f4a7c15ULL + cle.fils[2];
+    h = h * 0x9e3779b97f4a7c15ULL + cle.fils[3];
+    return (std::size_t)(h ^ (h >> 29));
+}
+
+MoteurHashlife::MoteurHashlife(std::size_t limiteNoeuds)
+    : limiteNoeuds(limiteNoeuds), seuilCollecte(limiteNoeuds), collecteDemandee(false), saturation(false),
+      noyau(choisirNoyau(regle)) {}
+
+// Les résultats mémorisés dépendent de la règle : ils sont oubliés, les noeuds (contenu seul) restent
+void MoteurHashlife::setRegle(const RegleVie& nouvelle) {
+    if (nouvelle == regle) return;
+    regle = nouvelle;
+    noyau = choisirNoyau(regle);
+    for (Noeud& noeud : noeuds) noeud.resultat = AUCUN;
+}
+
+void MoteurHashlife::charger(const GrilleBits& etat) {
+    courant = etat;
+    precedent = etat; // Aucun changement avant la première étape
+    tampon.redimensionner(etat.getNbLignes(), etat.getNbColonnes());
+    construction.clear(); // Les noeuds restent valides : ils ne dépendent que de leur contenu
+}
+
+// Réserve un emplacement de noeud et demande une collecte si la limite est dépassée
+uint32_t MoteurHashlife::allouer() {
+    uint32_t n;
+    if (!libres.empty()) {
+        n = libres.back();
+        libres.pop_back();
+    } else {
+        n = (uint32_t)noeuds.size();
+        noeuds.emplace_back();
+    }
+    if (nombreNoeuds() > seuilCollecte) collecteDemandee = true;
+    return n;
+}
+
+uint32_t MoteurHashlife::creerFeuille(uint64_t bits) {
+    auto it = feuilles.find(bits);
+    if (it != feuilles.end()) return it->second;
+    uint32_t n = allouer();
+    Noeud& noeud = noeuds[n];
+    noeud.fils[0] = noeud.fils[1] = noeud.fils[2] = noeud.fils[3] = AUCUN;
+    noeud.resultat = AUCUN;
+    noeud.bits = bits;
+    noeud.niveau = 3;
+    noeud.vide = bits == 0;
+    noeud.marque = false;
+    feuilles.emplace(bits, n);
+    return n;
+}
+
+// Noeud canonique ayant ces quatre quadrants (un seul exemplaire par contenu)
+uint32_t MoteurHashlife::creer(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se) {
+    CleNoeud cle = {{nw, ne, sw, se}};
+    auto it = table.find(cle);
+    if (it != table.end()) return it->second;
+    uint32_t n = allouer();
+    Noeud& noeud = noeuds[n];
+    noeud.fils[0] = nw; noeud.fils[1] = ne; noeud.fils[2] = sw; noeud.fils[3] = se;
+    noeud.resultat = AUCUN;
+    noeud.bits = 0;
+    noeud.niveau = noeuds[nw].niveau + 1;
+    noeud.vide = noeuds[nw].vide && noeuds[ne].vide && noeuds[sw].vide && noeuds[se].vide;
+    noeud.marque = false;
+    table.emplace(cle, n);
+    return n;
+}
+
+uint32_t MoteurHashlife::vide(int niveau) {
+    if ((int)videParNiveau.size() <= niveau) videParNiveau.resize(niveau + 1, AUCUN);
+    if (videParNiveau[niveau] == AUCUN) {
+        uint32_t n;
+        if (niveau == 3) n = creerFeuille(0);
+        else {
+            uint32_t f = vide(niveau - 1);
+            n = creer(f, f, f, f);
+        }
+        videParNiveau[niveau] = n;
+    }
+    return videParNiveau[niveau];
+}
+
+// 8 cellules consécutives de la ligne x à partir de la colonne y (coordonnées déjà ramenées dans le tore)
+uint64_t MoteurHashlife::extraire8(long long x, long long y) const {
+    const int nbColonnes = courant.getNbColonnes();
+    const uint64_t* ligne = courant.ligne((int)x);
+    if (y + 8 <= nbColonnes) {
+        int k = (int)(y >> 6), decalage = (int)(y & 63);
+        uint64_t mot = ligne[k] >> decalage;
+        if (decalage > 56) mot |= ligne[k + 1] << (64 - decalage);
+        return mot & 0xFF;
+    }
+    uint64_t octet = 0;
+    for (int c = 0; c < 8; ++c) {
+        int colonne = (int)((y + c) % nbColonnes);
+        octet |= (uint64_t)((ligne[colonne >> 6] >> (colonne & 63)) & 1) << c;
+    }
+    return octet;
+}
+
+// Noeud couvrant le carré [x0, x0 + 2^niveau) x [y0, y0 + 2^niveau) du pavage périodique du tore
+uint32_t MoteurHashlife::construire(int niveau, long long x0, long long y0) {
+    const long long nbLignes = courant.getNbLignes(), nbColonnes = courant.getNbColonnes();
+    long long xm = ((x0 % nbLignes) + nbLignes) % nbLignes;
+    long long ym = ((y0 % nbColonnes) + nbColonnes) % nbColonnes;
+    assert(niveau < 64 && xm < (1LL << 29) && ym < (1LL << 29)); // Champs de 6, 29 et 29 bits de la clé
+    uint64_t cle = ((uint64_t)niveau << 58) | ((uint64_t)xm << 29) | (uint64_t)ym;
+    auto it = construction.find(cle);
+    if (it != construction.end()) return it->second;
+
+    uint32_t n;
+    if (niveau == 3) {
+        uint64_t bits = 0;
+        for (int r = 0; r < 8; ++r) bits |= extraire8((xm + r) % nbLignes, ym) << (8 * r);
+        n = creerFeuille(bits);
+    } else {
+        long long h = 1LL << (niveau - 1);
+        uint32_t nw = construire(niveau - 1, xm, ym);
+        uint32_t ne = construire(niveau - 1, xm, ym + h);
+        uint32_t sw = construire(niveau - 1, xm + h, ym);
+        uint32_t se = construire(niveau - 1, xm + h, ym + h);
+        n = creer(nw, ne, sw, se);
+    }
+    construction.emplace(cle, n);
+    return n;
+}
+
+// Cas de base : noeud 16x16 dont le centre 8x8 est avancé de 4 générations par force brute
+uint32_t MoteurHashlife::resultatFeuilles(uint32_t n) {
+    uint32_t lignes[16];
+    uint64_t nw = noeuds[noeuds[n].fils[0]].bits, ne = noeuds[noeuds[n].fils[1]].bits;
+    uint64_t sw = noeuds[noeuds[n].fils[2]].bits, se = noeuds[noeuds[n].fils[3]].bits;
+    for (int r = 0; r < 8; ++r) {
+        lignes[r] = (uint32_t)((nw >> (8 * r)) & 0xFF) | (uint32_t)((ne >> (8 * r)) & 0xFF) << 8;
+        lignes[8 + r] = (uint32_t)((sw >> (8 * r)) & 0xFF) | (uint32_t)((se >> (8 * r)) & 0xFF) << 8;
+    }
+    for (int t = 0; t < 4; ++t) etape16(lignes, regle);
+    uint64_t bits = 0;
+    for (int r = 0; r < 8; ++r) bits |= (uint64_t)((lignes[4 + r] >> 4) & 0xFF) << (8 * r);
+    return creerFeuille(bits);
+}
+
+// Centre du noeud n avancé de 2^(niveau-2) générations. L'appelant doit avoir placé n sur la pile.
+uint32_t MoteurHashlife::resultat(uint32_t n) {
+    if (noeuds[n].resultat != AUCUN) return noeuds[n].resultat;
+    if (collecteDemandee) collecter(); // Point sûr : tous les noeuds en cours d'utilisation sont sur la pile
+
+    const int niveau = noeuds[n].niveau;
+    uint32_t r;
+    if (noeuds[n].vide) {
+        r = vide(niveau - 1);
+    } else if (niveau == 4) {
+        r = resultatFeuilles(n);
+    } else {
+        const std::size_t base = pile.size();
+        uint32_t a = noeuds[n].fils[0], b = noeuds[n].fils[1], c = noeuds[n].fils[2], d = noeuds[n].fils[3];
+        const Noeud na = noeuds[a], nb = noeuds[b], nc = noeuds[c], nd = noeuds[d];
+
+        // Les neuf sous-noeuds qui se chevauchent, au niveau inférieur
+        uint32_t sous[9] = {
+            a, creer(na.fils[1], nb.fils[0], na.fils[3], nb.fils[2]), b,
+            creer(na.fils[2], na.fils[3], nc.fils[0], nc.fils[1]),
+            creer(na.fils[3], nb.fils[2], nc.fils[1], nd.fils[0]),
+            creer(nb.fils[2], nb.fils[3], nd.fils[0], nd.fils[1]),
+            c, creer(nc.fils[1], nd.fils[0], nc.fils[3], nd.fils[2]), d};
+        for (uint32_t s : sous) pile.push_back(s);
+
+        // Première moitié du saut
+        uint32_t demi[9];
+        for (int i = 0; i < 9; ++i) {
+            demi[i] = resultat(sous[i]);
+            pile.push_back(demi[i]);
+        }
+
+        // Seconde moitié : quatre noeuds recomposés, avancés à leur tour
+        uint32_t quarts[4];
+        for (int i = 0; i < 2; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                uint32_t q = creer(demi[3 * i + j], demi[3 * i + j + 1], demi[3 * (i + 1) + j], demi[3 * (i + 1) + j + 1]);
+                pile.push_back(q);
+                quarts[2 * i + j] = resultat(q);
+                pile.push_back(quarts[2 * i + j]);
+            }
+        }
+        r = creer(quarts[0], quarts[1], quarts[2], quarts[3]);
+        pile.resize(base);
+    }
+    noeuds[n].resultat = r;
+    return r;
+}
+
+// Recopie le contenu du noeud placé en (x, y) dans la grille, en ignorant ce qui dépasse du tore
+void MoteurHashlife::ecrire(uint32_t n, int niveau, long long x, long long y, GrilleBits& sortie) const {
+    const int nbLignes = sortie.getNbLignes(), nbColonnes = sortie.getNbColonnes();
+    if (x >= nbLignes || y >= nbColonnes || noeuds[n].vide) return;
+    if (niveau == 3) {
+        uint64_t masque = y + 8 <= nbColonnes ? 0xFF : ((1ULL << (nbColonnes - y)) - 1);
+        for (int r = 0; r < 8 && x + r < nbLignes; ++r) {
+            uint64_t octet = (noeuds[n].bits >> (8 * r)) & masque;
+            sortie.ligne((int)(x + r))[y >> 6] |= octet << (y & 63); // y est multiple de 8 : l'octet tient dans un mot
+        }
+        return;
+    }
+    long long h = 1LL << (niveau - 1);
+    ecrire(noeuds[n].fils[0], niveau - 1, x, y, sortie);
+    ecrire(noeuds[n].fils[1], niveau - 1, x, y + h, sortie);
+    ecrire(noeuds[n].fils[2], niveau - 1, x + h, y, sortie);
+    ecrire(noeuds[n].fils[3], niveau - 1, x + h, y + h, sortie);
+}
+
+void MoteurHashlife::marquer(uint32_t n) {
+    if (n == AUCUN || noeuds[n].marque) return;
+    noeuds[n].marque = true;
+    if (noeuds[n].niveau > 3) {
+        for (uint32_t f : noeuds[n].fils) marquer(f);
+    }
+}
+
+// Ramasse-miettes : conserve les noeuds accessibles depuis la pile, libère les autres
+void MoteurHashlife::collecter() {
+    for (uint32_t n : pile) marquer(n);
+    for (uint32_t n : videParNiveau) marquer(n);
+
+    table.clear();
+    feuilles.clear();
+    construction.clear();
+    for (uint32_t n = 0; n < noeuds.size(); ++n) {
+        Noeud& noeud = noeuds[n];
+        if (noeud.niveau == 0) continue; // Déjà libre
+        if (!noeud.marque) {
+            noeud.niveau = 0;
+            libres.push_back(n);
+            continue;
+        }
+        if (noeud.resultat != AUCUN && !noeuds[noeud.resultat].marque) noeud.resultat = AUCUN;
+        if (noeud.niveau == 3) feuilles.emplace(noeud.bits, n);
+        else table.emplace(CleNoeud{{noeud.fils[0], noeud.fils[1], noeud.fils[2], noeud.fils[3]}}, n);
+    }
+    for (Noeud& noeud : noeuds) noeud.marque = false;
+
+    // Si les noeuds protégés par la pile occupent l'essentiel de la limite, le saut en cours se termine avec un
+    // seuil relevé (sinon chaque allocation déclencherait une collecte) et les sauts suivants seront plus petits
+    if (nombreNoeuds() > limiteNoeuds / 2) {
+        saturation = true;
+        seuilCollecte = std::max(seuilCollecte, 2 * nombreNoeuds());
+    }
+    collecteDemandee = false;
+}
+
+void MoteurHashlife::sauter(int k) {
+    const int niveau = k + 2;
+    const long long taille = 1LL << (k + 1); // Côté du centre d'un noeud : un bloc de la grille
+    const int nbLignes = courant.getNbLignes(), nbColonnes = courant.getNbColonnes();
+    tampon.redimensionner(nbLignes, nbColonnes);
+
+    for (long long bx = 0; bx < nbLignes; bx += taille) {
+        for (long long by = 0; by < nbColonnes; by += taille) {
+            if (collecteDemandee) collecter();
+            uint32_t n = construire(niveau, bx - taille / 2, by - taille / 2);
+            pile.push_back(n);
+            uint32_t r = resultat(n);
+            ecrire(r, niveau - 1, bx, by, tampon);
+            pile.clear();
+        }
+    }
+    construction.clear(); // Le pavage change avec la génération
+    std::swap(courant, tampon);
+
+    // Entre deux sauts, la pile est vide : la limite redevient une borne dure
+    seuilCollecte = limiteNoeuds;
+    if (nombreNoeuds() > limiteNoeuds) collecter();
+}
+
+void MoteurHashlife::etape() {
+    precedent = courant;
+    const int nbLignes = courant.getNbLignes();
+    for (int x = 0; x < nbLignes; ++x) {
+        noyau(courant.ligne((x - 1 + nbLignes) % nbLignes), courant.ligne(x), courant.ligne((x + 1) % nbLignes),
+              tampon.ligne(x), courant.getNbColonnes(), courant.getMotsParLigne(), 0, courant.getMotsParLigne(), regle);
+    }
+    std::swap(courant, tampon);
+}
+
+// Décompose n en puissances de deux : les petits restes sont calculés directement.
+// Les sauts sont limités à la taille du tore : un noeud plus grand ne contient que des copies du tore et
+// déborderait la clé de construction et la taille des blocs pour les plus grands n. Au-delà, on boucle à ce
+// niveau, et un cycle de la grille d'un saut à l'autre (méthode de Brent, comparaison exacte avec une seule
+// grille de repère) retire d'un coup tous les tours restants.
+void MoteurHashlife::avancer(long long n) {
+    GrilleBits depart = courant;
+
+    const int nbLignes = courant.getNbLignes(), nbColonnes = courant.getNbColonnes();
+    int kMax = 2;
+    while ((1LL << kMax) < nbLignes || (1LL << kMax) < nbColonnes) ++kMax;
+
+    GrilleBits repere;
+    long long puissance = 1, longueur = 0; // Sauts de 2^kMax depuis le repère
+    while (n > 0) {
+        if (n < 4) {
+            etape();
+            --n;
+            continue;
+        }
+        int k = std::min(63 - __builtin_clzll((unsigned long long)n), kMax);
+        sauter(k);
+        n -= 1LL << k;
+        if (saturation) { // Trop de noeuds pour des sauts de cette taille
+            saturation = false;
+            kMax = std::max(2, k - 1);
+            repere = GrilleBits();
+            puissance = 1;
+            longueur = 0;
+            continue;
+        }
+        if (k < kMax) continue;
+        ++longueur;
+        if (courant == repere) {
+            const long long tours = (n >> kMax) / longueur; // Cycles complets de longueur sauts encore à faire
+            n -= (tours * longueur) << kMax;
+        } else if (longueur == puissance) {
+            repere = courant;
+            puissance *= 2;
+            longueur = 0;
+        }
+    }
+    precedent = std::move(depart);
+}
+
+void MoteurHashlife::exporter(GrilleBits& etat) const { etat = courant; }
+
+void MoteurHashlife::cellulesChangees(std::vector<uint64_t>& cles) const {
+    cles.clear();
+    for (int i = 0; i < courant.getNbLignes(); ++i) {
+        const uint64_t* a = courant.ligne(i);
+        const uint64_t* b = precedent.ligne(i);
+        for (int k = 0; k < courant.getMotsParLigne(); ++k) {
+            for (uint64_t diff = a[k] ^ b[k]; diff; diff &= diff - 1) {
+                cles.push_back(cleCellule(i, 64 * k + __builtin_ctzll(diff)));
+            }
+        }
+    }
+}
+
+bool MoteurHashlife::estVivante(int x, int y) const { return courant.get(x, y); }
+long long MoteurHashlife::population() const { return courant.population(); }
+std::string MoteurHashlife::nom() const { return "hashlife"; }
+std::size_t MoteurHashlife::nombreNoeuds() const { return noeuds.size() - libres.size(); }
@@ -0,0 +1,76 @@
+#ifndef MOTEURHASHLIFE_H
+#define MOTEURHASHLIFE_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "Moteur.h"
+#include "NoyauDense.h"
+
+// Moteur Hashlife : arbre quaternaire mémoïsé qui avance de 2^k générations en un appel.
+// Le tore est vu comme un pavage périodique du plan : chaque bloc de la grille est le centre d'un noeud
+// construit à partir de ce pavage, ce qui donne exactement le même résultat que les autres moteurs.
+// Les noeuds sont partagés (hash-consing) et un ramasse-miettes borne leur nombre : entre deux sauts, jamais plus
+// de limiteNoeuds noeuds vivants ; si un saut en demande trop, les suivants sont plus petits.
+class MoteurHashlife : public Moteur {
+private:
+    static constexpr uint32_t AUCUN = 0xFFFFFFFFu;
+
+    struct Noeud {
+        uint32_t fils[4];   // Quadrants nord-ouest, nord-est, sud-ouest, sud-est (niveau > 3)
+        uint32_t resultat;  // Centre avancé de 2^(niveau-2) générations, ou AUCUN
+        uint64_t bits;      // Cellules d'une feuille 8x8 (niveau 3), octet r = ligne r
+        uint8_t niveau;     // Le noeud couvre 2^niveau x 2^niveau cellules (0 = emplacement libre)
+        bool vide;
+        bool marque;
+    };
+    struct CleNoeud {
+        uint32_t fils[4];
+        bool operator==(const CleNoeud& other) const;
+    };
+    struct HachageCleNoeud {
+        std::size_t operator()(const CleNoeud& cle) const;
+    };
+
+    GrilleBits courant, precedent, tampon; // État matérialisé du tore
+    std::vector<Noeud> noeuds;
+    std::vector<uint32_t> libres;
+    std::unordered_map<CleNoeud, uint32_t, HachageCleNoeud> table;
+    std::unordered_map<uint64_t, uint32_t> feuilles;
+    std::unordered_map<uint64_t, uint32_t> construction; // (niveau, position modulo le tore) -> noeud
+    std::vector<uint32_t> videParNiveau;
+    std::vector<uint32_t> pile;          // Racines temporaires protégées du ramasse-miettes
+    std::size_t limiteNoeuds;            // Borne dure entre deux sauts
+    std::size_t seuilCollecte;           // Relevé pendant un saut dont les noeuds protégés dépassent la moitié de la limite
+    bool collecteDemandee;
+    bool saturation;                     // Le dernier saut a relevé le seuil : avancer réduit la taille des sauts
+    NoyauLigne noyau;                    // Étapes simples, calculées directement sur la grille
+
+    uint32_t allouer();
+    uint32_t creerFeuille(uint64_t bits);
+    uint32_t creer(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se);
+    uint32_t vide(int niveau);
+    uint32_t construire(int niveau, long long x0, long long y0);
+    uint64_t extraire8(long long x, long long y) const;
+    uint32_t resultat(uint32_t n);
+    uint32_t resultatFeuilles(uint32_t n);
+    void ecrire(uint32_t n, int niveau, long long x, long long y, GrilleBits& sortie) const;
+    void marquer(uint32_t n);
+    void collecter();
+    void sauter(int k); // Avance de 2^k générations (k >= 2)
+
+public:
+    MoteurHashlife(std::size_t limiteNoeuds = 1 << 22);
+    void setRegle(const RegleVie& nouvelle) override;
+    void charger(const GrilleBits& etat) override;
+    void etape() override;
+    void avancer(long long n) override;
+    void exporter(GrilleBits& etat) const override;
+    void cellulesChangees(std::vector<uint64_t>& cles) const override;
+    bool estVivante(int x, int y) const override;
+    long long population() const override;
+    std::string nom() const override;
+    std::size_t nombreNoeuds() const;
+};
+
+#endif // MOTEURHASHLIFE_H
@@ -0,0 +1,280 @@
+#include "MoteurHybride.h"
+#include <algorithm>
+
+namespace {
+
+// Comptes de la tuile avec une marge de 2 : les cellules du bord des voisines (-1 ou 64) notifient sans test
+const int LARGEUR = 68;
+
+int indiceCompte(int ligne, int colonne) { return (ligne + 2) * LARGEUR + colonne + 2; }
+
+// Tuiles d'une série d'au moins longueur tuiles actives consécutives dans le mot (une série à cheval sur deux mots est coupée)
+uint64_t series(uint64_t actives, int longueur) {
+    uint64_t debuts = actives;
+    for (int i = 1; i < longueur; ++i) debuts &= actives >> i;
+    uint64_t couvertes = 0;
+    for (int i = 0; i < longueur; ++i) couvertes |= debuts << i;
+    return couvertes;
+}
+
+} // namespace
+
+MoteurHybride::MoteurHybride() : comptes(LARGEUR * LARGEUR, 0), nbNotifiees(0), numeroEtape(0) {
+    notifiees.resize(comptes.size());
+}
+
+bool MoteurHybride::complete(int b, int k) const {
+    return (b + 1) * HAUTEUR_TUILE <= courant.getNbLignes() && (k + 1) * 64 <= courant.getNbColonnes();
+}
+
+// Une liste réécrite pendant l'étape en cours garde l'ancienne dans l'autre moitié
+const uint16_t* MoteurHybride::listeDebut(int tuile, int& taille, uint8_t& bords) const {
+    const EnteteTuile& entete = entetes[tuile];
+    const int moitie = entete.miseAJour == numeroEtape ? 1 - entete.indice : entete.indice;
+    taille = entete.taille[moitie];
+    bords = entete.bords[moitie];
+    return positions[tuile].cellules[moitie];
+}
+
+void MoteurHybride::publier(int tuile, int taille, uint8_t bords) {
+    EnteteTuile& entete = entetes[tuile];
+    entete.indice = (uint8_t)(1 - entete.indice);
+    entete.taille[entete.indice] = (int8_t)taille;
+    entete.bords[entete.indice] = bords;
+    entete.miseAJour = numeroEtape;
+}
+
+bool MoteurHybride::ecrireListe(int b, int k, const GrilleBits& grille, int limite) {
+    const int mots = grille.getMotsParLigne(), premiere = b * HAUTEUR_TUILE, tuile = b * mots + k;
+    int vivantes = 0;
+    for (int r = 0; r < HAUTEUR_TUILE && vivantes <= limite; ++r) vivantes += __builtin_popcountll(grille.ligne(premiere + r)[k]);
+    if (vivantes > limite) return false;
+
+    uint16_t* cellules = positions[tuile].cellules[1 - entetes[tuile].indice];
+    uint64_t colonnes = 0;
+    int n = 0;
+    for (int r = 0; r < HAUTEUR_TUILE; ++r) {
+        const uint64_t ligne = grille.ligne(premiere + r)[k];
+        colonnes |= ligne;
+        for (uint64_t mot = ligne; mot; mot &= mot - 1) cellules[n++] = (uint16_t)(64 * r + __builtin_ctzll(mot));
+    }
+    const uint8_t bords = (grille.ligne(premiere)[k] ? LIGNE_HAUT : 0) | (grille.ligne(premiere + HAUTEUR_TUILE - 1)[k] ? LIGNE_BAS : 0) |
+                          (colonnes & 1 ? COLONNE_GAUCHE : 0) | (colonnes >> 63 ? COLONNE_DROITE : 0);
+    publier(tuile, n, bords);
+    prochainesCreuses[(size_t)b * motsBandes + k / 64] |= 1ULL << (k % 64);
+    return true;
+}
+
+void MoteurHybride::rendreDense(int b, int k) {
+    publier(b * courant.getMotsParLigne() + k, -1, 0);
+    prochainesCreuses[(size_t)b * motsBandes + k / 64] &= ~(1ULL << (k % 64));
+}
+
+void MoteurHybride::voisines(int b, int k, int bandes[3], int colonnes[3]) const {
+    const int mots = courant.getMotsParLigne();
+    bandes[0] = b > 0 ? b - 1 : nbBandes - 1;
+    bandes[1] = b;
+    bandes[2] = b + 1 < nbBandes ? b + 1 : 0;
+    colonnes[0] = k > 0 ? k - 1 : mots - 1;
+    colonnes[1] = k;
+    colonnes[2] = k + 1 < mots ? k + 1 : 0;
+}
+
+// Sans branchement : la cellule est toujours écrite en fin de liste, qui ne s'allonge qu'à son premier compte
+void MoteurHybride::notifier(int indice) {
+    for (const int decalage : {-LARGEUR - 1, -LARGEUR, -LARGEUR + 1, -1, 1, LARGEUR - 1, LARGEUR, LARGEUR + 1}) {
+        uint8_t& compte = comptes[indice + decalage];
+        notifiees[nbNotifiees] = (uint16_t)(indice + decalage);
+        nbNotifiees += compte == 0;
+        compte++;
+    }
+}
+
+// Voisine dense : sa ligne, sa colonne ou son coin en contact avec la tuile est lu dans la grille
+void MoteurHybride::notifierBordDense(int b, int k, int db, int dk) {
+    const int nbLignes = courant.getNbLignes(), nbColonnes = courant.getNbColonnes(), premiere = b * HAUTEUR_TUILE;
+    const int ligne = db < 0 ? (premiere + nbLignes - 1) % nbLignes : (premiere + HAUTEUR_TUILE) % nbLignes;
+    const int colonne = dk < 0 ? (64 * k + nbColonnes - 1) % nbColonnes : (64 * k + 64) % nbColonnes;
+    const int ligneTuile = db < 0 ? -1 : HAUTEUR_TUILE, colonneTuile = dk < 0 ? -1 : 64;
+    if (!dk) {
+        for (uint64_t mot = courant.ligne(ligne)[k]; mot; mot &= mot - 1) notifier(indiceCompte(ligneTuile, __builtin_ctzll(mot)));
+    } else if (!db) {
+        for (int r = 0; r < HAUTEUR_TUILE; ++r) {
+            if (courant.get(premiere + r, colonne)) notifier(indiceCompte(r, colonneTuile));
+        }
+    } else if (courant.get(ligne, colonne)) {
+        notifier(indiceCompte(ligneTuile, colonneTuile));
+    }
+}
+
+// Comptes poussés par les cellules vivantes, comme le moteur creux, sur un tableau de 64x64 au lieu d'une table
+// de hachage. Une cellule vivante est toujours évaluée (elle peut mourir sans voisine) ; une cellule jamais
+// notifiée reste morte, les règles B0 étant refusées.
+void MoteurHybride::calculerCreuse(int b, int k, uint64_t* modifiees, BilanEtape& bilan) {
+    const int mots = courant.getMotsParLigne(), premiere = b * HAUTEUR_TUILE;
+    const int tuile = b * mots + k;
+    int taille;
+    uint8_t bords;
+    const uint16_t* cellules = listeDebut(tuile, taille, bords);
+    for (int i = 0; i < taille; ++i) {
+        const int indice = indiceCompte(cellules[i] >> 6, cellules[i] & 63);
+        notifiees[nbNotifiees] = (uint16_t)indice;
+        nbNotifiees += comptes[indice] == 0;
+        comptes[indice] |= VIVANTE;
+        notifier(indice);
+    }
+    // Voisines : seules leurs cellules du bord qui touche la tuile (coordonnées -1 ou 64) comptent
+    int bandes[3], colonnes[3];
+    voisines(b, k, bandes, colonnes);
+    for (int db = -1; db <= 1; ++db) {
+        for (int dk = -1; dk <= 1; ++dk) {
+            if (!db && !dk) continue;
+            const uint8_t requis = (db < 0 ? LIGNE_BAS : db > 0 ? LIGNE_HAUT : 0) | (dk < 0 ? COLONNE_DROITE : dk > 0 ? COLONNE_GAUCHE : 0);
+            const uint16_t* autres = listeDebut(bandes[db + 1] * mots + colonnes[dk + 1], taille, bords);
+            if (taille < 0) {
+                notifierBordDense(b, k, db, dk);
+                continue;
+            }
+            if ((bords & requis) != requis) continue;
+            for (int i = 0; i < taille; ++i) {
+                const int ligne = (autres[i] >> 6) + HAUTEUR_TUILE * db, colonne = (autres[i] & 63) + 64 * dk;
+                if (ligne >= -1 && ligne <= HAUTEUR_TUILE && colonne >= -1 && colonne <= 64) notifier(indiceCompte(ligne, colonne));
+            }
+        }
+    }
+
+    // Évaluation sans branchement : une cellule de la marge (calculée par la tuile voisine) ne naît jamais
+    const uint32_t transitions = regle.naissance | (uint32_t)regle.survie << 16;
+    uint64_t lignes[HAUTEUR_TUILE] = {};
+    uint16_t* nouvelles = positions[tuile].cellules[1 - entetes[tuile].indice];
+    int n = 0, naissances = 0, morts = 0;
+    uint32_t modifiee = 0;
+    for (int i = 0; i < nbNotifiees; ++i) {
+        const int indice = notifiees[i];
+        const uint32_t compte = comptes[indice];
+        comptes[indice] = 0;
+        const unsigned r = indice / LARGEUR - 2, c = indice % LARGEUR - 2;
+        const uint32_t vivante = compte >> 4;
+        const uint32_t suivante = (transitions >> ((compte & 0x0F) + 16 * vivante)) & (r < HAUTEUR_TUILE && c < 64);
+        modifiee |= suivante ^ vivante;
+        naissances += suivante & ~vivante;
+        morts += vivante & ~suivante;
+        lignes[r % HAUTEUR_TUILE] |= (uint64_t)suivante << (c % 64);
+        nouvelles[std::min(n, CAPACITE_LISTE)] = (uint16_t)(64 * r + c);
+        n += suivante;
+    }
+    nbNotifiees = 0;
+
+    // Tuile inchangée à l'étape précédente et à celle-ci : déjà identique dans les deux tampons, liste conservée
+    if (modifiee || ((changees[(size_t)b * motsBandes + k / 64] >> (k % 64)) & 1)) {
+        for (int r = 0; r < HAUTEUR_TUILE; ++r) suivant.ligne(premiere + r)[k] = lignes[r];
+    }
+    if (n > CAPACITE_LISTE) {
+        rendreDense(b, k);
+    } else if (modifiee) {
+        uint64_t occupees = 0;
+        for (int r = 0; r < HAUTEUR_TUILE; ++r) occupees |= lignes[r];
+        publier(tuile, n, (lignes[0] ? LIGNE_HAUT : 0) | (lignes[HAUTEUR_TUILE - 1] ? LIGNE_BAS : 0) |
+                              (occupees & 1 ? COLONNE_GAUCHE : 0) | (occupees >> 63 ? COLONNE_DROITE : 0));
+    }
+    if (modifiee) {
+        modifiees[k / 64] |= 1ULL << (k % 64);
+        bilan.tuilesModifiees++;
+    }
+    if (modifiee && suiviStatistiques) {
+        // n est la population exacte de la tuile, même au-delà de la capacité de la liste
+        populationTuiles[tuile] = (uint32_t)n;
+        uint64_t& occupation = occupees[(size_t)b * motsBandes + k / 64];
+        occupation = n ? occupation | (1ULL << (k % 64)) : occupation & ~(1ULL << (k % 64));
+        bilan.naissances += naissances;
+        bilan.morts += morts;
+    }
+    bilan.tuilesCalculees++;
+}
+
+// Les tuiles creuses passent par les listes, sauf dans une longue série de tuiles actives que le noyau
+// vectoriel calcule d'un seul appel par ligne ; les autres passent par le noyau dense.
+// Ensuite : liste relue pour une tuile creuse calculée par le noyau, densité des tuiles denses modifiées contrôlée
+// toutes les PERIODE_DENSITE étapes, et celle des tuiles denses devenues stables à chaque étape.
+void MoteurHybride::calculerBande(int b, uint64_t* actives, uint64_t* modifiees, BilanEtape& bilan) {
+    uint64_t toutes = 0;
+    for (int m = 0; m < motsBandes; ++m) toutes |= actives[m];
+    if (!toutes) return; // Bande stable
+
+    const uint64_t* typeCreux = &creuses[(size_t)b * motsBandes];
+    uint64_t* parListes = calculCreux.data();
+    uint64_t* longues = calculCreux.data() + motsBandes;
+    for (int m = 0; m < motsBandes; ++m) {
+        longues[m] = series(actives[m], SERIE_DENSE);
+        parListes[m] = actives[m] & typeCreux[m] & ~longues[m];
+        actives[m] &= ~parListes[m];
+    }
+
+    MoteurDense::calculerBande(b, actives, modifiees, bilan);
+
+    const bool controle = numeroEtape % PERIODE_DENSITE == 0;
+    for (int m = 0; m < motsBandes; ++m) {
+        // Dans une longue série, la tuile a de bonnes chances d'y rester : dense jusqu'au prochain contrôle
+        for (uint64_t relire = actives[m] & typeCreux[m] & modifiees[m]; relire; relire &= relire - 1) {
+            const int t = __builtin_ctzll(relire), k = 64 * m + t;
+            if (((longues[m] >> t) & 1) || !ecrireListe(b, k, suivant, CAPACITE_LISTE)) rendreDense(b, k);
+        }
+        for (uint64_t denses = controle ? actives[m] & ~typeCreux[m] & modifiees[m] : 0; denses; denses &= denses - 1) {
+            const int k = 64 * m + __builtin_ctzll(denses);
+            if (complete(b, k)) ecrireListe(b, k, suivant, SEUIL_CREUSE);
+        }
+        // Tuile dense devenue stable : elle ne sera plus active, donc plus contrôlée, tant qu'une voisine ne change
+        // pas ; relue comme au chargement pour que ses voisines creuses n'aillent pas lire son bord dans la grille
+        for (uint64_t stables = actives[m] & ~typeCreux[m] & ~modifiees[m]; stables; stables &= stables - 1) {
+            const int k = 64 * m + __builtin_ctzll(stables);
+            if (complete(b, k)) ecrireListe(b, k, suivant, CAPACITE_LISTE);
+        }
+    }
+    for (int m = 0; m < motsBandes; ++m) {
+        for (uint64_t calculees = parListes[m]; calculees; calculees &= calculees - 1) {
+            calculerCreuse(b, 64 * m + __builtin_ctzll(calculees), modifiees, bilan);
+        }
+    }
+}
+
+void MoteurHybride::charger(const GrilleBits& etat) {
+    MoteurDense::charger(etat);
+    const int mots = etat.getMotsParLigne();
+    entetes.assign((size_t)nbBandes * mots, EnteteTuile());
+    positions.resize((size_t)nbBandes * mots);
+    creuses.assign(changees.size(), 0);
+    prochainesCreuses.assign(changees.size(), 0);
+    calculCreux.assign(2 * (size_t)motsBandes, 0);
+    numeroEtape = 0;
+    listerTuiles();
+}
+
+void MoteurHybride::listerTuiles() {
+    const int mots = courant.getMotsParLigne();
+    for (int b = 0; b < nbBandes; ++b) {
+        for (int k = 0; k < mots; ++k) {
+            if (!complete(b, k) || !ecrireListe(b, k, courant, CAPACITE_LISTE)) rendreDense(b, k);
+        }
+    }
+    creuses = prochainesCreuses;
+}
+
+void MoteurHybride::avancerBlocs(int generations) {
+    MoteurDense::avancerBlocs(generations);
+    listerTuiles();
+}
+
+void MoteurHybride::etape() {
+    numeroEtape++;
+    prochainesCreuses = creuses;
+    MoteurDense::etape();
+    std::swap(creuses, prochainesCreuses);
+}
+
+long long MoteurHybride::tuilesCreuses() const {
+    long long total = 0;
+    for (const uint64_t mot : creuses) total += __builtin_popcountll(mot);
+    return total;
+}
+
+std::string MoteurHybride::nom() const { return "hybride"; }
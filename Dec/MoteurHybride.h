@@ -0,0 +1,71 @@
+#ifndef MOTEURHYBRIDE_H
+#define MOTEURHYBRIDE_H
+
+#include <vector>
+#include <cstdint>
+#include "MoteurDense.h"
+
+// Moteur hybride : chaque tuile de 64x64 cellules est creuse (liste des positions de ses cellules vivantes)
+// ou dense (mots de la grille seuls). À chaque étape, une tuile active creuse est calculée depuis les listes :
+// chaque cellule vivante de la tuile et du bord des voisines (liste d'une voisine creuse, grille d'une voisine
+// dense) notifie ses voisines, comme dans le moteur creux mais sans table de hachage. Les autres tuiles actives
+// passent par le noyau bit à bit du moteur dense. La grille de bits reste la référence (export, changements).
+// Conversions amorties : une tuile creuse devient dense au-delà de CAPACITE_LISTE cellules, une tuile dense
+// modifiée n'est recomptée que toutes les PERIODE_DENSITE étapes et redevient creuse sous SEUIL_CREUSE cellules ;
+// une tuile dense devenue stable est recomptée aussitôt, comme au chargement.
+// Avec setProfondeur, les passages du blocage temporel ne voient que la grille : les listes sont relues ensuite.
+// Avec suivreStatistiques, une tuile creuse compte ses naissances et ses morts pendant son évaluation.
+class MoteurHybride : public MoteurDense {
+private:
+    static constexpr int CAPACITE_LISTE = 31;  // Deux listes de 32 positions : deux lignes de cache
+    static constexpr int SEUIL_CREUSE = 15;
+    static constexpr int PERIODE_DENSITE = 8;
+    static constexpr int SERIE_DENSE = 8;      // Séries de tuiles actives laissées au noyau dense (8 mots : un registre AVX-512)
+    static constexpr uint8_t VIVANTE = 0x10;   // Bit de comptes au-dessus du nombre de voisines
+    static constexpr uint8_t LIGNE_HAUT = 1, LIGNE_BAS = 2, COLONNE_GAUCHE = 4, COLONNE_DROITE = 8; // Bords occupés
+
+    // Deux listes alternées par tuile : la liste du début de l'étape reste lisible par les voisines pendant
+    // qu'elle est remplacée. Les en-têtes, compacts, évitent de lire les positions d'une voisine dont le bord
+    // qui touche la tuile est vide.
+    struct EnteteTuile {
+        uint32_t miseAJour; // Étape où la liste la plus récente a été écrite
+        int8_t taille[2];   // -1 : tuile dense
+        uint8_t bords[2];
+        uint8_t indice;     // Liste la plus récente
+    };
+    struct alignas(64) PositionsTuile {
+        uint16_t cellules[2][CAPACITE_LISTE + 1]; // Ligne * 64 + colonne dans la tuile (une case d'écriture en trop)
+    };
+
+    std::vector<EnteteTuile> entetes;     // Indice b * mots + k
+    std::vector<PositionsTuile> positions;
+    std::vector<uint64_t> creuses;        // Bit k de la bande b : tuile (b, k) creuse au début de l'étape
+    std::vector<uint64_t> prochainesCreuses;
+    std::vector<uint64_t> calculCreux;    // Tuiles de la bande calculées depuis les listes, puis tuiles des longues séries
+    std::vector<uint8_t> comptes;         // Voisines notifiées de chaque cellule de la tuile, marge de 2 cellules comprise
+    std::vector<uint16_t> notifiees;      // Cellules dont le compte est non nul ou vivantes
+    int nbNotifiees;
+    uint32_t numeroEtape;
+
+    bool complete(int b, int k) const; // Tuile de 64 lignes sur 64 colonnes (les tuiles du bord peuvent être partielles)
+    const uint16_t* listeDebut(int tuile, int& taille, uint8_t& bords) const; // Liste au début de l'étape
+    void publier(int tuile, int taille, uint8_t bords); // La liste écrite dans l'autre moitié devient la plus récente
+    bool ecrireListe(int b, int k, const GrilleBits& grille, int limite); // Tuile creuse si elle a au plus limite cellules
+    void rendreDense(int b, int k);
+    void voisines(int b, int k, int bandes[3], int colonnes[3]) const; // Bandes et colonnes de tuiles voisines sur le tore
+    void notifier(int indice); // Ajoute une voisine aux 8 cellules autour de celle d'indice donné dans comptes
+    void notifierBordDense(int b, int k, int db, int dk); // Cellules de la voisine dense (db, dk) en contact avec la tuile
+    void calculerCreuse(int b, int k, uint64_t* modifiees, BilanEtape& bilan);
+    void calculerBande(int b, uint64_t* actives, uint64_t* modifiees, BilanEtape& bilan) override;
+    void listerTuiles(); // Listes de toutes les tuiles depuis la grille courante (chargement, blocage temporel)
+    void avancerBlocs(int generations) override; // Passage sur la grille seule, puis listes relues
+
+public:
+    MoteurHybride();
+    void charger(const GrilleBits& etat) override;
+    void etape() override;
+    long long tuilesCreuses() const; // Tuiles actuellement creuses
+    std::string nom() const override;
+};
+
+#endif // MOTEURHYBRIDE_H
@@ -0,0 +1,98 @@
+#include "MoteurParallele.h"
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+MoteurParallele::MoteurParallele(int nbThreads) : nbThreads(nbThreads) {
+    pool = std::make_unique<PoolBandes>(getNbThreads());
+    travailleurs.resize(pool->getNbTravailleurs());
+    zones.resize(pool->getNbTravailleurs());
+}
+
+int MoteurParallele::getNbThreads() const {
+    if (pool) return pool->getNbTravailleurs();
+#ifdef _OPENMP
+    return nbThreads > 0 ? nbThreads : omp_get_max_threads(); // OMP_NUM_THREADS, comme la version OpenMP d'origine
+#else
+    return nbThreads > 0 ? nbThreads : (int)std::max(1u, std::thread::hardware_concurrency());
+#endif
+}
+
+int MoteurParallele::premiereBande(int travailleur) const {
+    return (int)((long long)nbBandes * travailleur / pool->getNbTravailleurs());
+}
+
+// Les pages des deux tampons sont rendues puis réécrites par le travailleur propriétaire de chaque bande
+void MoteurParallele::charger(const GrilleBits& etat) {
+    MoteurDense::charger(etat);
+    for (Travailleur& travailleur : travailleurs) travailleur.cellules = 0;
+    if (pool->getNbTravailleurs() == 1) return;
+    const int nbLignes = etat.getNbLignes();
+    const size_t octetsLigne = (size_t)etat.getMotsParLigne() * sizeof(uint64_t);
+    pool->executer([this, &etat, nbLignes, octetsLigne](int t) {
+        const int debut = std::min(premiereBande(t) * HAUTEUR_TUILE, nbLignes);
+        const int fin = std::min(premiereBande(t + 1) * HAUTEUR_TUILE, nbLignes);
+        if (debut == fin) return;
+        for (GrilleBits* tampon : {&courant, &suivant}) {
+            PoolBandes::replacerPages(tampon->ligne(debut), (fin - debut) * octetsLigne);
+            memcpy(tampon->ligne(debut), etat.ligne(debut), (fin - debut) * octetsLigne);
+        }
+    });
+}
+
+void MoteurParallele::etape() {
+    pool->executer([this](int t) {
+        Travailleur& travailleur = travailleurs[t];
+        travailleur.bilan = BilanEtape();
+        calculerBandes(premiereBande(t), premiereBande(t + 1), travailleur.bilan);
+        travailleur.cellules += travailleur.bilan.tuilesCalculees * HAUTEUR_TUILE * 64;
+    });
+    BilanEtape bilan;
+    for (const Travailleur& travailleur : travailleurs) bilan += travailleur.bilan;
+    terminerEtape(bilan);
+}
+
+void MoteurParallele::avancerBlocs(int generations) {
+    const int nbLignes = courant.getNbLignes(), nbColonnes = courant.getNbColonnes();
+    const int lignesBlocs = (nbLignes + LIGNES_BLOC - 1) / LIGNES_BLOC;
+    const int blocsParLigne = lignesBlocs ? nombreBlocs() / lignesBlocs : 0;
+
+    pool->executer([this, generations, nbLignes, nbColonnes, lignesBlocs, blocsParLigne](int t) {
+        const int debut = std::min((premiereBande(t) * HAUTEUR_TUILE + LIGNES_BLOC - 1) / LIGNES_BLOC, lignesBlocs);
+        const int fin = std::min((premiereBande(t + 1) * HAUTEUR_TUILE + LIGNES_BLOC - 1) / LIGNES_BLOC, lignesBlocs);
+        Travailleur& travailleur = travailleurs[t];
+        travailleur.octets = passerBlocs(debut * blocsParLigne, fin * blocsParLigne, generations, zones[t]);
+        const long long lignes = std::min(fin * LIGNES_BLOC, nbLignes) - std::min(debut * LIGNES_BLOC, nbLignes);
+        travailleur.cellules += lignes * nbColonnes * generations;
+    });
+    for (const Travailleur& travailleur : travailleurs) octets += travailleur.octets;
+    std::swap(courant, suivant);
+}
+
+// Les changements de chaque bande sont listés en parallèle puis concaténés dans l'ordre des lignes
+void MoteurParallele::cellulesChangees(std::vector<uint64_t>& cles) const {
+    const int threads = pool->getNbTravailleurs();
+    if (threads <= 1) {
+        MoteurDense::cellulesChangees(cles);
+        return;
+    }
+    pool->executer([this](int t) {
+        std::vector<uint64_t>& locales = travailleurs[t].changements;
+        locales.clear();
+        listerChangements(premiereBande(t), premiereBande(t + 1), locales);
+    });
+
+    cles.clear();
+    for (const Travailleur& travailleur : travailleurs) cles.insert(cles.end(), travailleur.changements.begin(), travailleur.changements.end());
+}
+
+void MoteurParallele::cellulesParNoeud(std::vector<long long>& cellules) const {
+    cellules.assign(pool->getNbNoeuds(), 0);
+    for (int t = 0; t < pool->getNbTravailleurs(); ++t) cellules[pool->noeud(t)] += travailleurs[t].cellules;
+}
+
+std::string MoteurParallele::nom() const { return "parallele"; }
@@ -0,0 +1,40 @@
+#ifndef MOTEURPARALLELE_H
+#define MOTEURPARALLELE_H
+
+#include <memory>
+#include "MoteurDense.h"
+#include "PoolBandes.h"
+
+// Moteur dense parallèle : travailleurs persistants fixés sur les coeurs (PoolBandes), chacun propriétaire
+// d'une série fixe de bandes de tuiles contiguës. Au chargement, chaque travailleur recopie lui-même sa bande
+// dans les deux tampons : ses pages sont allouées sur son nœud NUMA (premier contact).
+// Chaque travailleur lit la génération courante (partagée en lecture seule, lignes voisines comprises)
+// et écrit sa bande dans le tampon suivant : la seule synchronisation est la barrière de fin d'étape.
+class MoteurParallele : public MoteurDense {
+private:
+    // État propre à un travailleur, sur sa propre ligne de cache
+    struct alignas(64) Travailleur {
+        BilanEtape bilan;       // Réutilisé d'une étape à l'autre
+        long long cellules = 0; // Cellules calculées depuis le chargement
+        long long octets = 0;   // Passage de blocage temporel en cours
+        std::vector<uint64_t> changements; // Cellules basculées de ses bandes (capacité réutilisée)
+    };
+
+    int nbThreads; // Nombre de threads demandé (0 = valeur par défaut d'OpenMP, ou tous les coeurs)
+    std::unique_ptr<PoolBandes> pool;
+    mutable std::vector<Travailleur> travailleurs; // cellulesChangees remplit leurs listes de changements
+
+    int premiereBande(int travailleur) const; // Bandes [premiereBande(t), premiereBande(t + 1)) du travailleur t
+    void avancerBlocs(int generations) override; // Blocs dont la première ligne est dans les bandes du travailleur
+
+public:
+    MoteurParallele(int nbThreads = 0);
+    void charger(const GrilleBits& etat) override;
+    void etape() override;
+    void cellulesChangees(std::vector<uint64_t>& cles) const override;
+    std::string nom() const override;
+    int getNbThreads() const; // Nombre de threads réellement utilisés
+    void cellulesParNoeud(std::vector<long long>& cellules) const; // Par nœud NUMA, depuis le chargement
+};
+
+#endif // MOTEURPARALLELE_H
@@ -0,0 +1,237 @@
+#include "MoteurPlan.h"
+#include "Empreinte.h"
+#include <cstring>
+#include <algorithm>
+
+namespace {
+
+inline void additionner(uint64_t a, uint64_t b, uint64_t c, uint64_t& somme, uint64_t& retenue) {
+    uint64_t t = a ^ b;
+    somme = t ^ c;
+    retenue = (a & b) | (t & c);
+}
+
+// Voisins de gauche et de droite d'une ligne de tuile, avec le bit qui vient de la tuile voisine
+inline uint64_t versOuest(uint64_t ligne, uint64_t ouest) { return (ligne << 1) | (ouest >> 63); }
+inline uint64_t versEst(uint64_t ligne, uint64_t est) { return (ligne >> 1) | (est << 63); }
+
+const uint64_t LIGNES_VIDES[64] = {0};
+
+} // namespace
+
+MoteurPlan::MoteurPlan() : nbLignes(0), nbColonnes(0), totalTuiles(0) {}
+
+const MoteurPlan::Tuile* MoteurPlan::trouver(int32_t tx, int32_t ty) const {
+    auto it = index.find(cleTuile(tx, ty));
+    return it == index.end() ? nullptr : &tuiles[it->second];
+}
+
+uint32_t MoteurPlan::obtenir(int32_t tx, int32_t ty) {
+    auto [it, nouvelle] = index.emplace(cleTuile(tx, ty), 0);
+    if (!nouvelle) return it->second;
+    uint32_t n;
+    if (!libres.empty()) {
+        n = libres.back();
+        libres.pop_back();
+    } else {
+        n = (uint32_t)tuiles.size();
+        tuiles.emplace_back();
+    }
+    Tuile& tuile = tuiles[n];
+    tuile.tx = tx;
+    tuile.ty = ty;
+    memset(tuile.cellules, 0, sizeof(tuile.cellules));
+    memset(tuile.precedentes, 0, sizeof(tuile.precedentes));
+    it->second = n;
+    occupees.push_back(n);
+    return n;
+}
+
+void MoteurPlan::charger(const GrilleBits& etat) {
+    nbLignes = etat.getNbLignes();
+    nbColonnes = etat.getNbColonnes();
+    tuiles.clear();
+    libres.clear();
+    occupees.clear();
+    index.clear();
+    totalTuiles = 0;
+    for (int x = 0; x < nbLignes; ++x) {
+        const uint64_t* ligne = etat.ligne(x);
+        for (int k = 0; k < etat.getMotsParLigne(); ++k) {
+            if (!ligne[k]) continue;
+            // Les tuiles sont alignées sur les mots de la grille : colonne 64k + j = bit j de la tuile k
+            Tuile& tuile = tuiles[obtenir(x >> 6, k)];
+            tuile.cellules[x & 63] = ligne[k];
+            tuile.precedentes[x & 63] = ligne[k]; // Aucun changement avant la première étape
+        }
+    }
+}
+
+// Une tuile vide ne redeviendra vivante que par une voisine active, qui la recréera si besoin
+void MoteurPlan::liberer() {
+    std::size_t garde = 0;
+    for (uint32_t n : occupees) {
+        Tuile& tuile = tuiles[n];
+        uint64_t vivantes = 0;
+        for (int r = 0; r < TAILLE; ++r) vivantes |= tuile.cellules[r];
+        if (vivantes) {
+            occupees[garde++] = n;
+        } else {
+            index.erase(cleTuile(tuile.tx, tuile.ty));
+            libres.push_back(n);
+        }
+    }
+    occupees.resize(garde);
+}
+
+// Une cellule vivante sur un bord peut faire naître des cellules dans la tuile voisine
+void MoteurPlan::etendre() {
+    const std::size_t nombre = occupees.size(); // Les tuiles créées ici sont vides : pas besoin de les parcourir
+    for (std::size_t i = 0; i < nombre; ++i) {
+        const int32_t tx = tuiles[occupees[i]].tx, ty = tuiles[occupees[i]].ty;
+        const uint64_t* c = tuiles[occupees[i]].cellules;
+        uint64_t colonnes = 0;
+        for (int r = 0; r < TAILLE; ++r) colonnes |= c[r];
+        const bool nord = c[0] != 0, sud = c[TAILLE - 1] != 0;
+        const bool ouest = colonnes & 1, est = colonnes >> 63;
+        const bool nordOuest = c[0] & 1, nordEst = c[0] >> 63;
+        const bool sudOuest = c[TAILLE - 1] & 1, sudEst = c[TAILLE - 1] >> 63;
+
+        // obtenir peut déplacer les tuiles : c n'est plus utilisé après ce point
+        if (nord) obtenir(tx - 1, ty);
+        if (sud) obtenir(tx + 1, ty);
+        if (ouest) obtenir(tx, ty - 1);
+        if (est) obtenir(tx, ty + 1);
+        if (nordOuest) obtenir(tx - 1, ty - 1);
+        if (nordEst) obtenir(tx - 1, ty + 1);
+        if (sudOuest) obtenir(tx + 1, ty - 1);
+        if (sudEst) obtenir(tx + 1, ty + 1);
+    }
+}
+
+void MoteurPlan::calculer(Tuile& tuile) {
+    auto lignes = [this](int32_t tx, int32_t ty) {
+        const Tuile* t = trouver(tx, ty);
+        return t ? t->cellules : LIGNES_VIDES;
+    };
+    const uint64_t* c = tuile.cellules;
+    const uint64_t* n = lignes(tuile.tx - 1, tuile.ty);
+    const uint64_t* s = lignes(tuile.tx + 1, tuile.ty);
+    const uint64_t* o = lignes(tuile.tx, tuile.ty - 1);
+    const uint64_t* e = lignes(tuile.tx, tuile.ty + 1);
+    const uint64_t* no = lignes(tuile.tx - 1, tuile.ty - 1);
+    const uint64_t* ne = lignes(tuile.tx - 1, tuile.ty + 1);
+    const uint64_t* so = lignes(tuile.tx + 1, tuile.ty - 1);
+    const uint64_t* se = lignes(tuile.tx + 1, tuile.ty + 1);
+
+    for (int r = 0; r < TAILLE; ++r) {
+        // Ligne du dessus et ligne du dessous, éventuellement dans les tuiles nord et sud
+        uint64_t h = r > 0 ? c[r - 1] : n[TAILLE - 1];
+        uint64_t hO = r > 0 ? o[r - 1] : no[TAILLE - 1], hE = r > 0 ? e[r - 1] : ne[TAILLE - 1];
+        uint64_t b = r < TAILLE - 1 ? c[r + 1] : s[0];
+        uint64_t bO = r < TAILLE - 1 ? o[r + 1] : so[0], bE = r < TAILLE - 1 ? e[r + 1] : se[0];
+
+        uint64_t sHaut, rHaut, sBas, rBas;
+        additionner(versOuest(h, hO), h, versEst(h, hE), sHaut, rHaut);
+        additionner(versOuest(b, bO), b, versEst(b, bE), sBas, rBas);
+        uint64_t ouest = versOuest(c[r], o[r]), est = versEst(c[r], e[r]);
+        uint64_t sMilieu = ouest ^ est, rMilieu = ouest & est;
+
+        uint64_t b0, u1, v0, v1;
+        additionner(sHaut, sBas, sMilieu, b0, u1);
+        additionner(rHaut, rBas, rMilieu, v0, v1);
+        uint64_t b1 = v0 ^ u1, w1 = v0 & u1;
+        uint64_t b2 = v1 ^ w1, b3 = v1 & w1;
+        tuile.precedentes[r] = appliquerRegle(regle, b0, b1, b2, b3, c[r]);
+    }
+}
+
+void MoteurPlan::etape() {
+    liberer();
+    etendre();
+    // Toutes les tuiles lisent la génération courante des voisines : l'échange n'a lieu qu'à la fin
+    for (uint32_t n : occupees) calculer(tuiles[n]);
+    totalTuiles += occupees.size();
+    for (uint32_t n : occupees) std::swap(tuiles[n].cellules, tuiles[n].precedentes);
+}
+
+void MoteurPlan::exporter(GrilleBits& etat) const {
+    if (etat.getNbLignes() != nbLignes || etat.getNbColonnes() != nbColonnes) etat.redimensionner(nbLignes, nbColonnes);
+    else etat.effacer();
+    const uint64_t masque = etat.masqueDernierMot();
+    for (uint32_t n : occupees) {
+        const Tuile& tuile = tuiles[n];
+        if (tuile.ty < 0 || tuile.ty >= etat.getMotsParLigne()) continue;
+        for (int r = 0; r < TAILLE; ++r) {
+            long long x = 64LL * tuile.tx + r;
+            if (x < 0 || x >= nbLignes) continue;
+            uint64_t mot = tuile.cellules[r];
+            if (tuile.ty == etat.getMotsParLigne() - 1) mot &= masque; // Hors de la fenêtre à droite
+            etat.ligne((int)x)[tuile.ty] = mot;
+        }
+    }
+}
+
+void MoteurPlan::cellulesChangees(std::vector<uint64_t>& cles) const {
+    cles.clear();
+    for (uint32_t n : occupees) {
+        const Tuile& tuile = tuiles[n];
+        for (int r = 0; r < TAILLE; ++r) {
+            for (uint64_t diff = tuile.cellules[r] ^ tuile.precedentes[r]; diff; diff &= diff - 1) {
+                cles.push_back(cleCellule(64 * tuile.tx + r, 64 * tuile.ty + __builtin_ctzll(diff)));
+            }
+        }
+    }
+}
+
+bool MoteurPlan::estVivante(int x, int y) const {
+    const Tuile* tuile = trouver(x >> 6, y >> 6);
+    return tuile && ((tuile->cellules[x & 63] >> (y & 63)) & 1);
+}
+
+long long MoteurPlan::population() const {
+    long long total = 0;
+    for (uint32_t n : occupees) {
+        for (int r = 0; r < TAILLE; ++r) total += __builtin_popcountll(tuiles[n].cellules[r]);
+    }
+    return total;
+}
+
+// Chaque tuile garde la génération précédente : naissances et morts par popcount, tuile par tuile
+void MoteurPlan::statistiques(StatistiquesGeneration& stats) const {
+    stats = StatistiquesGeneration();
+    stats.tuilesModifiees = 0;
+    bool trouvee = false;
+    for (uint32_t n : occupees) {
+        const Tuile& tuile = tuiles[n];
+        uint64_t difference = 0, colonnes = 0;
+        int premiere = -1, derniere = -1;
+        for (int r = 0; r < TAILLE; ++r) {
+            const uint64_t avant = tuile.precedentes[r], apres = tuile.cellules[r];
+            difference |= avant ^ apres;
+            stats.population += __builtin_popcountll(apres);
+            stats.naissances += __builtin_popcountll(apres & ~avant);
+            stats.morts += __builtin_popcountll(avant & ~apres);
+            colonnes |= apres;
+            if (apres) {
+                if (premiere < 0) premiere = r;
+                derniere = r;
+            }
+        }
+        if (difference) stats.tuilesModifiees++;
+        if (!colonnes) continue;
+        const int ligneMin = 64 * tuile.tx + premiere, ligneMax = 64 * tuile.tx + derniere;
+        const int colonneMin = 64 * tuile.ty + __builtin_ctzll(colonnes), colonneMax = 64 * tuile.ty + 63 - __builtin_clzll(colonnes);
+        stats.ligneMin = trouvee ? std::min(stats.ligneMin, ligneMin) : ligneMin;
+        stats.ligneMax = trouvee ? std::max(stats.ligneMax, ligneMax) : ligneMax;
+        stats.colonneMin = trouvee ? std::min(stats.colonneMin, colonneMin) : colonneMin;
+        stats.colonneMax = trouvee ? std::max(stats.colonneMax, colonneMax) : colonneMax;
+        trouvee = true;
+    }
+}
+
+long long MoteurPlan::tuilesCalculees() const { return totalTuiles; }
+
+std::string MoteurPlan::nom() const { return "plan"; }
+
+std::size_t MoteurPlan::nombreTuiles() const { return occupees.size(); }
@@ -0,0 +1,51 @@
+#ifndef MOTEURPLAN_H
+#define MOTEURPLAN_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "Moteur.h"
+
+// Moteur sur un plan infini : seules les tuiles de 64x64 cellules occupées existent, rangées dans une
+// table de hachage indexée par leurs coordonnées de tuile. Une tuile voisine est créée quand l'activité
+// atteint un bord, et une tuile vide est libérée. Mémoire et temps suivent la région vivante.
+// La grille chargée et exportée (lignes [0, nbLignes), colonnes [0, nbColonnes)) n'est qu'une fenêtre sur le plan.
+class MoteurPlan : public Moteur {
+private:
+    static constexpr int TAILLE = 64; // Côté d'une tuile : une ligne de tuile = un mot de 64 bits
+
+    struct Tuile {
+        int32_t tx, ty;              // Coordonnées de la tuile (cellules [64 tx, 64 tx + 63] x [64 ty, 64 ty + 63])
+        uint64_t cellules[TAILLE];   // Génération courante, bit j de la ligne r = cellule (64 tx + r, 64 ty + j)
+        uint64_t precedentes[TAILLE]; // Génération précédente (puis tampon de calcul)
+    };
+
+    int nbLignes, nbColonnes;              // Fenêtre exportée
+    std::vector<Tuile> tuiles;
+    std::vector<uint32_t> libres;          // Emplacements de tuiles libérées
+    std::vector<uint32_t> occupees;        // Emplacements en service
+    std::unordered_map<uint64_t, uint32_t> index; // (tx, ty) -> emplacement
+    long long totalTuiles;                 // Tuiles calculées depuis le chargement
+
+    static uint64_t cleTuile(int32_t tx, int32_t ty) { return ((uint64_t)(uint32_t)tx << 32) | (uint32_t)ty; }
+    const Tuile* trouver(int32_t tx, int32_t ty) const;
+    uint32_t obtenir(int32_t tx, int32_t ty); // Crée la tuile (vide) si elle n'existe pas
+    void liberer();                           // Libère les tuiles vides
+    void etendre();                           // Crée les voisines des tuiles actives sur leurs bords
+    void calculer(Tuile& tuile);              // Génération suivante de la tuile dans precedentes
+
+public:
+    MoteurPlan();
+    void charger(const GrilleBits& etat) override;
+    void etape() override;
+    void exporter(GrilleBits& etat) const override;
+    void cellulesChangees(std::vector<uint64_t>& cles) const override;
+    bool estVivante(int x, int y) const override;
+    long long population() const override;
+    long long tuilesCalculees() const override;
+    void statistiques(StatistiquesGeneration& stats) const override;
+    std::string nom() const override;
+    std::size_t nombreTuiles() const;
+};
+
+#endif // MOTEURPLAN_H
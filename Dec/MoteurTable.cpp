@@ -0,0 +1,112 @@
+#include "MoteurTable.h"
+#include "Empreinte.h"
+#include <utility>
+
+using namespace std;
+
+MoteurTable::MoteurTable() : table(1 << 16), motsEtendus(0) { construireTable(); }
+
+void MoteurTable::setRegle(const RegleVie& nouvelle) {
+    Moteur::setRegle(nouvelle);
+    construireTable();
+}
+
+// Bit 4 * l + c de l'indice : cellule (l, c) du voisinage 4x4 ; le bloc est formé des cellules (1..2, 1..2)
+void MoteurTable::construireTable() {
+    for (int indice = 0; indice < (1 << 16); ++indice) {
+        uint8_t bloc = 0;
+        for (int l = 1; l <= 2; ++l) {
+            for (int c = 1; c <= 2; ++c) {
+                int voisines = 0;
+                for (int dl = -1; dl <= 1; ++dl) {
+                    for (int dc = -1; dc <= 1; ++dc) {
+                        if (dl || dc) voisines += (indice >> (4 * (l + dl) + c + dc)) & 1;
+                    }
+                }
+                if (regle.application((indice >> (4 * l + c)) & 1, voisines)) bloc |= 1 << (2 * (l - 1) + c - 1);
+            }
+        }
+        table[indice] = bloc;
+    }
+}
+
+void MoteurTable::charger(const GrilleBits& etat) {
+    courant = etat;
+    suivant = etat; // Aucun changement avant la première étape
+    motsEtendus = etat.getMotsParLigne() + 1; // Colonnes jusqu'à C + 1, et un mot lu au-delà de la ligne
+    etendues.assign((size_t)etat.getNbLignes() * motsEtendus, 0);
+}
+
+void MoteurTable::etendre(int ligne) {
+    const int nbColonnes = courant.getNbColonnes(), mots = courant.getMotsParLigne();
+    const uint64_t* source = courant.ligne(ligne);
+    uint64_t* etendue = &etendues[(size_t)ligne * motsEtendus];
+    uint64_t retenue = courant.get(ligne, nbColonnes - 1); // Bit 0 : colonne C - 1
+    for (int k = 0; k < mots; ++k) {
+        etendue[k] = (source[k] << 1) | retenue;
+        retenue = source[k] >> 63;
+    }
+    etendue[mots] = retenue;
+    for (int q = nbColonnes + 1; q <= nbColonnes + 2; ++q) { // Colonnes C et C + 1 du tore
+        if (courant.get(ligne, (q - 1) % nbColonnes)) etendue[q >> 6] |= 1ULL << (q & 63);
+    }
+}
+
+// Un mot de sortie par moitiés de 32 colonnes (16 blocs) : chaque ligne du voisinage y fournit une fenêtre
+// de 34 bits, dont les blocs lisent 4 bits tous les 2 bits
+void MoteurTable::etape() {
+    const int nbLignes = courant.getNbLignes(), mots = courant.getMotsParLigne();
+    if (nbLignes == 0 || courant.getNbColonnes() == 0) return;
+    for (int i = 0; i < nbLignes; ++i) etendre(i);
+    const uint64_t masque = courant.masqueDernierMot();
+    const uint8_t* blocs = table.data();
+
+    for (int x = 0; x < nbLignes; x += 2) {
+        const uint64_t* a = &etendues[(size_t)((x + nbLignes - 1) % nbLignes) * motsEtendus];
+        const uint64_t* b = &etendues[(size_t)x * motsEtendus];
+        const uint64_t* c = &etendues[(size_t)((x + 1) % nbLignes) * motsEtendus];
+        const uint64_t* d = &etendues[(size_t)((x + 2) % nbLignes) * motsEtendus];
+        uint64_t* haut = suivant.ligne(x);
+        uint64_t* bas = x + 1 < nbLignes ? suivant.ligne(x + 1) : nullptr; // Ligne fictive : non écrite
+
+        for (int k = 0; k < mots; ++k) {
+            uint64_t motHaut = 0, motBas = 0;
+            for (int moitie = 0; moitie < 64; moitie += 32) {
+                const uint64_t fa = moitie ? (a[k] >> 32) | (a[k + 1] << 32) : a[k];
+                const uint64_t fb = moitie ? (b[k] >> 32) | (b[k + 1] << 32) : b[k];
+                const uint64_t fc = moitie ? (c[k] >> 32) | (c[k + 1] << 32) : c[k];
+                const uint64_t fd = moitie ? (d[k] >> 32) | (d[k + 1] << 32) : d[k];
+                if (((fa | fb | fc | fd) & 0x3FFFFFFFFULL) == 0) continue; // Voisinage vide : reste vide (pas de B0)
+                for (int t = 0; t < 32; t += 2) {
+                    const uint8_t bloc = blocs[((fa >> t) & 15) | ((fb >> t) & 15) << 4 | ((fc >> t) & 15) << 8 | ((fd >> t) & 15) << 12];
+                    motHaut |= (uint64_t)(bloc & 3) << (moitie + t);
+                    motBas |= (uint64_t)(bloc >> 2) << (moitie + t);
+                }
+            }
+            if (k == mots - 1) { // Colonne fictive et bits au-delà de la grille
+                motHaut &= masque;
+                motBas &= masque;
+            }
+            haut[k] = motHaut;
+            if (bas) bas[k] = motBas;
+        }
+    }
+    std::swap(courant, suivant);
+}
+
+void MoteurTable::exporter(GrilleBits& etat) const { etat = courant; }
+
+void MoteurTable::cellulesChangees(std::vector<uint64_t>& cles) const {
+    cles.clear();
+    for (int i = 0; i < courant.getNbLignes(); ++i) {
+        const uint64_t* a = courant.ligne(i);
+        const uint64_t* p = suivant.ligne(i);
+        for (int k = 0; k < courant.getMotsParLigne(); ++k) {
+            for (uint64_t diff = a[k] ^ p[k]; diff; diff &= diff - 1) cles.push_back(cleCellule(i, 64 * k + __builtin_ctzll(diff)));
+        }
+    }
+}
+
+bool MoteurTable::estVivante(int x, int y) const { return courant.get(x, y); }
+long long MoteurTable::population() const { return courant.population(); }
+std::string MoteurTable::nom() const { return "table"; }
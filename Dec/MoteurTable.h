@@ -0,0 +1,37 @@
+#ifndef MOTEURTABLE_H
+#define MOTEURTABLE_H
+
+#include <vector>
+#include <cstdint>
+#include "Moteur.h"
+#include "GrilleBits.h"
+
+// Moteur par table de correspondance : le tore avance par blocs de 2x2 cellules. Le voisinage 4x4 d'un bloc
+// (16 bits, 4 bits par ligne) indexe une table de 65 536 entrées qui donne directement l'état suivant de ses
+// 4 cellules centrales. La table est recalculée à partir de la règle active : toute règle B/S a le même coût.
+// Lignes ou colonnes en nombre impair : le dernier bloc déborde sur une ligne ou une colonne fictive (lue sur
+// le tore, jamais écrite).
+class MoteurTable : public Moteur {
+private:
+    GrilleBits courant;  // Génération courante
+    GrilleBits suivant;  // Génération suivante, puis précédente après l'échange (cellulesChangees)
+    std::vector<uint8_t> table;      // Bits 0-1 : ligne haute du bloc suivant, bits 2-3 : ligne basse
+    std::vector<uint64_t> etendues;  // Lignes décalées d'une colonne, bords du tore recopiés (bit q = colonne q - 1)
+    int motsEtendus;
+
+    void construireTable();
+    void etendre(int ligne); // Ligne étendue : colonne C - 1, colonnes 0 à C - 1, puis colonnes 0 et 1
+
+public:
+    MoteurTable();
+    void setRegle(const RegleVie& nouvelle) override;
+    void charger(const GrilleBits& etat) override;
+    void etape() override;
+    void exporter(GrilleBits& etat) const override;
+    void cellulesChangees(std::vector<uint64_t>& cles) const override;
+    bool estVivante(int x, int y) const override;
+    long long population() const override;
+    std::string nom() const override;
+};
+
+#endif // MOTEURTABLE_H
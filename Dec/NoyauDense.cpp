@@ -0,0 +1,204 @@
+#if defined(__x86_64__) && defined(__GNUC__)
+#define NOYAU_SIMD // Variantes AVX2 et AVX-512, choisies à l'exécution
+// Les fonctions génériques sont entièrement intégrées (flatten) dans les variantes vectorielles :
+// aucun vecteur ne traverse un appel compilé sans AVX, l'avertissement d'ABI est sans objet.
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#include "NoyauDense.h"
+#include <cstring>
+
+namespace {
+
+// Voisins de gauche : le bit j reçoit la cellule de la colonne 64k + j - 1 (le tore relie la colonne 0 à la dernière)
+inline uint64_t versOuest(const uint64_t* ligne, int k, int motsParLigne, int reste) {
+    uint64_t entrant = k > 0 ? ligne[k - 1] >> 63 : (ligne[motsParLigne - 1] >> (reste - 1)) & 1;
+    return (ligne[k] << 1) | entrant;
+}
+
+// Voisins de droite : le bit j reçoit la cellule de la colonne 64k + j + 1
+inline uint64_t versEst(const uint64_t* ligne, int k, int motsParLigne, int reste) {
+    if (k < motsParLigne - 1) return (ligne[k] >> 1) | (ligne[k + 1] << 63);
+    return (ligne[k] >> 1) | ((ligne[0] & 1) << (reste - 1));
+}
+
+// Additionneur complet appliqué à tous les bits en parallèle (un mot ou un vecteur de mots)
+template <typename Mot>
+inline void additionner(Mot a, Mot b, Mot c, Mot& somme, Mot& retenue) {
+    Mot t = a ^ b;
+    somme = t ^ c;
+    retenue = (a & b) | (t & c);
+}
+
+// Génération suivante des cellules du milieu à partir des voisins déjà décalés
+template <uint16_t Naissance, uint16_t Survie, bool Generique, typename Mot>
+inline Mot evoluer(Mot hOuest, Mot h, Mot hEst, Mot ouest, Mot milieu, Mot est, Mot bOuest, Mot b, Mot bEst,
+                   const RegleVie& regle) {
+    // Somme des trois voisins du dessus, des trois du dessous et des deux latéraux
+    Mot sHaut, rHaut, sBas, rBas;
+    additionner(hOuest, h, hEst, sHaut, rHaut);
+    additionner(bOuest, b, bEst, sBas, rBas);
+    Mot sMilieu = ouest ^ est, rMilieu = ouest & est;
+
+    // Bits du nombre de voisins (0 à 8) : b0 + 2*b1 + 4*b2 + 8*b3
+    Mot b0, u1, v0, v1;
+    additionner(sHaut, sBas, sMilieu, b0, u1);  // Unités
+    additionner(rHaut, rBas, rMilieu, v0, v1);  // Deuxaines
+    Mot b1 = v0 ^ u1, w1 = v0 & u1;
+    Mot b2 = v1 ^ w1, b3 = v1 & w1;
+
+    return Generique ? appliquerRegle(regle, b0, b1, b2, b3, milieu)
+                     : appliquerRegle<Naissance, Survie>(b0, b1, b2, b3, milieu);
+}
+
+#ifdef NOYAU_SIMD
+typedef uint64_t Vecteur4 __attribute__((vector_size(32)));  // 4 mots : 256 cellules (AVX2)
+typedef uint64_t Vecteur8 __attribute__((vector_size(64)));  // 8 mots : 512 cellules (AVX-512)
+
+// Mots [k, finMots) par vecteurs entiers ; les décalages viennent de lectures décalées d'un mot (k - 1 et k + 1),
+// donc k >= 1 et finMots <= motsParLigne - 1 : les mots du bord du tore restent au calcul scalaire.
+// Retourne le premier mot non calculé.
+template <typename Vecteur, uint16_t Naissance, uint16_t Survie, bool Generique>
+inline int calculerVecteurs(const uint64_t* haut, const uint64_t* milieu, const uint64_t* bas,
+                            uint64_t* sortie, int k, int finMots, const RegleVie& regle) {
+    constexpr int LARGEUR = sizeof(Vecteur) / sizeof(uint64_t);
+    for (; k + LARGEUR <= finMots; k += LARGEUR) {
+        Vecteur v[3][3]; // Lignes du dessus, du milieu et du dessous ; mots k - 1, k et k + 1
+        const uint64_t* lignes[3] = {haut, milieu, bas};
+        for (int l = 0; l < 3; ++l) {
+            for (int d = 0; d < 3; ++d) memcpy(&v[l][d], lignes[l] + k - 1 + d, sizeof(Vecteur));
+        }
+        Vecteur ouest[3], est[3];
+        for (int l = 0; l < 3; ++l) {
+            ouest[l] = (v[l][1] << 1) | (v[l][0] >> 63);
+            est[l] = (v[l][1] >> 1) | (v[l][2] << 63);
+        }
+        Vecteur resultat = evoluer<Naissance, Survie, Generique>(ouest[0], v[0][1], est[0], ouest[1], v[1][1], est[1],
+                                                                 ouest[2], v[2][1], est[2], regle);
+        memcpy(sortie + k, &resultat, sizeof(Vecteur));
+    }
+    return k;
+}
+
+template <uint16_t Naissance, uint16_t Survie, bool Generique>
+__attribute__((target("avx2"), flatten)) int calculerAvx2(const uint64_t* haut, const uint64_t* milieu, const uint64_t* bas,
+                                                  uint64_t* sortie, int k, int finMots, const RegleVie& regle) {
+    return calculerVecteurs<Vecteur4, Naissance, Survie, Generique>(haut, milieu, bas, sortie, k, finMots, regle);
+}
+
+template <uint16_t Naissance, uint16_t Survie, bool Generique>
+__attribute__((target("avx512f"), flatten)) int calculerAvx512(const uint64_t* haut, const uint64_t* milieu, const uint64_t* bas,
+                                                       uint64_t* sortie, int k, int finMots, const RegleVie& regle) {
+    return calculerVecteurs<Vecteur8, Naissance, Survie, Generique>(haut, milieu, bas, sortie, k, finMots, regle);
+}
+#endif
+
+// Règle connue à la compilation, ou lue dans regle si Generique ; Jeu choisit les instructions du cœur de la ligne
+template <uint16_t Naissance, uint16_t Survie, bool Generique, JeuInstructions Jeu>
+void calculerLigne(const uint64_t* haut, const uint64_t* milieu, const uint64_t* bas,
+                   uint64_t* sortie, int nbColonnes, int motsParLigne, int motDebut, int motFin, const RegleVie& regle) {
+    const int reste = nbColonnes - 64 * (motsParLigne - 1); // Colonnes occupées dans le dernier mot
+    const uint64_t masqueFin = reste >= 64 ? ~0ULL : ((1ULL << reste) - 1);
+
+    int k = motDebut;
+    while (k < motFin) {
+#ifdef NOYAU_SIMD
+        if (k > 0 && k < motsParLigne - 1) {
+            const int finMots = motFin < motsParLigne - 1 ? motFin : motsParLigne - 1;
+            if constexpr (Jeu == JeuInstructions::Avx512) k = calculerAvx512<Naissance, Survie, Generique>(haut, milieu, bas, sortie, k, finMots, regle);
+            if constexpr (Jeu != JeuInstructions::Scalaire) k = calculerAvx2<Naissance, Survie, Generique>(haut, milieu, bas, sortie, k, finMots, regle);
+            if (k >= motFin) break;
+        }
+#endif
+        uint64_t suivant = evoluer<Naissance, Survie, Generique>(
+            versOuest(haut, k, motsParLigne, reste), haut[k], versEst(haut, k, motsParLigne, reste),
+            versOuest(milieu, k, motsParLigne, reste), milieu[k], versEst(milieu, k, motsParLigne, reste),
+            versOuest(bas, k, motsParLigne, reste), bas[k], versEst(bas, k, motsParLigne, reste), regle);
+        sortie[k] = k == motsParLigne - 1 ? suivant & masqueFin : suivant;
+        ++k;
+    }
+}
+
+// Parcours ligne par ligne : les mots lus sont contigus. Sans popcnt matériel, __builtin_popcountll est un appel
+// de bibliothèque : les mots inchangés sont alors sautés
+template <bool SautInchanges>
+inline void compterChangements(const uint64_t* avant, const uint64_t* apres, int pas, int nbLignes, int nbMots,
+                               uint64_t* differences, uint64_t* naissances, uint64_t* morts) {
+    for (int x = 0; x < nbLignes; ++x, avant += pas, apres += pas) {
+        for (int j = 0; j < nbMots; ++j) {
+            const uint64_t change = avant[j] ^ apres[j];
+            if (SautInchanges && !change) continue;
+            differences[j] |= change;
+            naissances[j] += __builtin_popcountll(change & apres[j]);
+            morts[j] += __builtin_popcountll(change & avant[j]);
+        }
+    }
+}
+
+#ifdef NOYAU_SIMD
+__attribute__((target("popcnt"), flatten)) void compterPopcnt(const uint64_t* avant, const uint64_t* apres, int pas, int nbLignes,
+                                                              int nbMots, uint64_t* differences, uint64_t* naissances, uint64_t* morts) {
+    compterChangements<false>(avant, apres, pas, nbLignes, nbMots, differences, naissances, morts);
+}
+#endif
+
+template <const RegleVie& R, JeuInstructions Jeu>
+constexpr NoyauLigne noyau() { return &calculerLigne<R.naissance, R.survie, false, Jeu>; }
+
+template <JeuInstructions Jeu>
+NoyauLigne choisirPour(const RegleVie& regle) {
+    if (regle == CONWAY) return noyau<CONWAY, Jeu>();
+    if (regle == HIGHLIFE) return noyau<HIGHLIFE, Jeu>();
+    if (regle == DAY_AND_NIGHT) return noyau<DAY_AND_NIGHT, Jeu>();
+    if (regle == SEEDS) return noyau<SEEDS, Jeu>();
+    if (regle == LIFE_WITHOUT_DEATH) return noyau<LIFE_WITHOUT_DEATH, Jeu>();
+    if (regle == MAZE) return noyau<MAZE, Jeu>();
+    if (regle == REPLICATOR) return noyau<REPLICATOR, Jeu>();
+    if (regle == DEUX_PAR_DEUX) return noyau<DEUX_PAR_DEUX, Jeu>();
+    return &calculerLigne<0, 0, true, Jeu>;
+}
+
+} // namespace
+
+// Détecté une seule fois (CPUID), au premier moteur créé
+JeuInstructions jeuInstructions() {
+#ifdef NOYAU_SIMD
+    static const JeuInstructions detecte = __builtin_cpu_supports("avx512f") ? JeuInstructions::Avx512
+                                         : __builtin_cpu_supports("avx2") ? JeuInstructions::Avx2
+                                                                          : JeuInstructions::Scalaire;
+    return detecte;
+#else
+    return JeuInstructions::Scalaire;
+#endif
+}
+
+const char* nomJeuInstructions(JeuInstructions jeu) {
+    switch (jeu) {
+        case JeuInstructions::Avx512: return "avx512";
+        case JeuInstructions::Avx2: return "avx2";
+        default: return "scalaire";
+    }
+}
+
+NoyauLigne choisirNoyau(const RegleVie& regle, JeuInstructions jeu) {
+    if (jeu > jeuInstructions()) jeu = jeuInstructions(); // Jamais d'instructions absentes du processeur
+    switch (jeu) {
+        case JeuInstructions::Avx512: return choisirPour<JeuInstructions::Avx512>(regle);
+        case JeuInstructions::Avx2: return choisirPour<JeuInstructions::Avx2>(regle);
+        default: return choisirPour<JeuInstructions::Scalaire>(regle);
+    }
+}
+
+CompteurChangements choisirCompteur(JeuInstructions jeu) {
+#ifdef NOYAU_SIMD
+    if (jeu != JeuInstructions::Scalaire && jeuInstructions() != JeuInstructions::Scalaire) return &compterPopcnt;
+#endif
+    (void)jeu;
+    return &compterChangements<true>;
+}
+
+void calculerLigneBits(const uint64_t* haut, const uint64_t* milieu, const uint64_t* bas,
+                       uint64_t* sortie, int nbColonnes, int motsParLigne) {
+    calculerLigne<CONWAY.naissance, CONWAY.survie, false, JeuInstructions::Scalaire>(haut, milieu, bas, sortie, nbColonnes,
+                                                                                   motsParLigne, 0, motsParLigne, CONWAY);
+}
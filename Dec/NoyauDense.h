@@ -0,0 +1,35 @@
+#ifndef NOYAUDENSE_H
+#define NOYAUDENSE_H
+
+#include <cstdint>
+#include "RegleVie.h"
+
+// Noyau de calcul bit à bit : 64 cellules par mot, voisins additionnés par des additionneurs complets.
+// Calcule les mots [motDebut, motFin) de la ligne suivante d'une ligne torique à partir des lignes
+// du dessus, du milieu et du dessous (0 et motsParLigne pour la ligne entière).
+typedef void (*NoyauLigne)(const uint64_t* haut, const uint64_t* milieu, const uint64_t* bas,
+                           uint64_t* sortie, int nbColonnes, int motsParLigne, int motDebut, int motFin,
+                           const RegleVie& regle);
+
+// Instructions vectorielles du noyau : 4 mots (AVX2) ou 8 mots (AVX-512) par opération, les mots du bord
+// du tore restant calculés en scalaire. Toutes les variantes donnent exactement le même résultat.
+enum class JeuInstructions { Scalaire, Avx2, Avx512 };
+JeuInstructions jeuInstructions(); // Meilleur jeu disponible sur ce processeur
+const char* nomJeuInstructions(JeuInstructions jeu);
+
+// Noyau de la règle : une version compilée pour chaque règle courante (règle intégrée à la boucle),
+// une version générique pour les autres (qui lit regle). Choisi une fois, pas à chaque cellule.
+// Un jeu absent du processeur est remplacé par le meilleur disponible.
+NoyauLigne choisirNoyau(const RegleVie& regle, JeuInstructions jeu = jeuInstructions());
+
+// Naissances, morts et OU des différences de nbMots tuiles adjacentes entre deux générations, ajoutés aux tableaux
+// (nbLignes lignes espacées de pas mots). Instruction popcnt quand le processeur l'a (AVX2 l'implique).
+typedef void (*CompteurChangements)(const uint64_t* avant, const uint64_t* apres, int pas, int nbLignes, int nbMots,
+                                    uint64_t* differences, uint64_t* naissances, uint64_t* morts);
+CompteurChangements choisirCompteur(JeuInstructions jeu = jeuInstructions());
+
+// Règle B3/S23
+void calculerLigneBits(const uint64_t* haut, const uint64_t* milieu, const uint64_t* bas,
+                       uint64_t* sortie, int nbColonnes, int motsParLigne);
+
+#endif // NOYAUDENSE_H
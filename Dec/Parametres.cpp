@@ -0,0 +1,235 @@
+#include "Parametres.h"
+#include <iostream>
+#include <string>
+#include <algorithm>
+using namespace std;
+
+void afficherUsage(const std::string& programme) {
+    cout << "Usage : " << programme << " [options] [fichier]\n"
+         << "  --fichier F        configuration initiale : matrice 0/1, RLE (.rle) ou plaintext (.cells)\n"
+         << "  --taille LxC       tore minimal autour d'un motif RLE ou .cells (defaut : taille du motif)\n"
+         << "  --iterations N     nombre maximal d'iterations (defaut 100)\n"
+         << "  --moteur NOM       creux, dense, hashlife, hybride, parallele, table (defaut creux) ou plan : plan infini\n"
+         << "                     dont la grille chargee n'est que la fenetre affichee et sauvegardee\n"
+         << "  --regle R          regle B/S (ex. B36/S23) ou nom : conway, highlife, daynight, seeds,\n"
+         << "                     lwod, maze, replicator, 2x2 (defaut B3/S23)\n"
+         << "  --threads N        threads du moteur parallele (defaut : OMP_NUM_THREADS ou tous les coeurs)\n"
+         << "  --saut N           atteint directement la generation N\n"
+         << "  --sortie DOSSIER   dossier des fichiers produits (defaut <nom>_<n>_out)\n"
+         << "  --intervalle N     sauvegarde une iteration sur N, 0 pour aucune (defaut 1)\n"
+         << "  --format F         archive (un fichier binaire, defaut), texte (un fichier par iteration)\n"
+         << "                     ou statistiques (flux de statistiques seul, aucune grille sauvegardee)\n"
+         << "  --statistiques     population, naissances, morts, tuiles modifiees et boite englobante\n"
+         << "                     de chaque generation dans statistiques.jdvs\n"
+         << "  --images-cles N    archive : une image complete tous les N enregistrements (defaut 64)\n"
+         << "  --file N           iterations en attente d'ecriture, 0 pour une ecriture synchrone (defaut 16)\n"
+         << "  --file-pleine P    bloquer (defaut) ou abandonner les iterations quand la file est pleine\n"
+         << "  --exporter A       convertit l'archive A au format texte dans le dossier --sortie\n"
+         << "                     (flux .jdvs : statistiques.csv)\n"
+         << "  --generations G    generations exportees : N ou A-B (defaut toutes)\n"
+         << "  --pixels N         taille des cellules a l'ecran (defaut 20)\n"
+         << "  --sans-fenetre     calcul sans affichage, au maximum de la vitesse du moteur\n"
+         << "  --pas N            fenetre : generations calculees par la touche N (defaut 1000)\n"
+         << "  --par-image N      fenetre : generations au plus par image, 0 sans limite (defaut 1)\n"
+         << "  --aleatoire LxC    soupe aleatoire de L lignes et C colonnes au lieu d'un fichier\n"
+         << "  --densite P        pourcentage de cellules vivantes de la soupe (defaut 50)\n"
+         << "  --graine N         graine de la soupe aleatoire (defaut 1)\n"
+         << "  --sans-cycle       desactive la detection des repetitions (mesures de performance)\n"
+         << "  --profondeur K     moteurs dense, parallele et hybride, sans fenetre, avec --sans-cycle et sans --statistiques :\n"
+         << "                     K generations (1 a 64) par passage de la grille en cache entre deux sauvegardes\n"
+         << "  --mesures F        duree des phases et compteurs par generation dans F (.json : JSON lines, sinon CSV) ;\n"
+         << "                     programme compile avec l'option CMake INSTRUMENTATION\n"
+         << "  --mesures-intervalle N  une ligne de mesures toutes les N generations (defaut 1)\n"
+         << "  --compteurs-materiel    ajoute cycles, instructions et defauts de cache (perf_event_open)\n"
+         << "  --reprise N        point de reprise toutes les N generations dans le dossier de sortie\n"
+         << "  --reprise-secondes S  point de reprise toutes les S secondes\n"
+         << "  --reprendre        repart du dernier point de reprise valide de --sortie (fichier inutile) avec le moteur,\n"
+         << "                     le format, les intervalles et les options de la simulation interrompue ;\n"
+         << "                     --iterations N la prolonge\n"
+         << "  --aide             affiche ce message\n"
+         << "Sans argument, les parametres sont demandes au clavier." << endl;
+}
+
+// Lit un entier positif ou nul ; retourne false si la valeur est invalide
+static bool lireEntier(const string& texte, long long& valeur) {
+    try {
+        size_t lus = 0;
+        valeur = stoll(texte, &lus);
+        return lus == texte.size() && valeur >= 0;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool lireArguments(int argc, char* argv[], Parametres& parametres) {
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--aide" || option == "-h") return false;
+        parametres.options.push_back(option);
+        if (option == "--sans-fenetre") { parametres.sansFenetre = true; continue; }
+        if (option == "--sans-cycle") { parametres.detectionCycles = false; continue; }
+        if (option == "--compteurs-materiel") { parametres.compteursMateriel = true; continue; }
+        if (option == "--reprendre") { parametres.reprendre = true; continue; }
+        if (option == "--statistiques") { parametres.statistiques = true; continue; }
+        if (option.rfind("--", 0) != 0) { parametres.fichier = option; continue; } // Argument positionnel : le fichier
+
+        if (i + 1 >= argc) {
+            cerr << "Erreur : valeur manquante pour " << option << endl;
+            return false;
+        }
+        string valeur = argv[++i];
+        long long nombre = 0;
+        bool numerique = lireEntier(valeur, nombre);
+
+        if (option == "--fichier") parametres.fichier = valeur;
+        else if (option == "--sortie") parametres.dossierSortie = valeur;
+        else if (option == "--moteur") {
+            if (!lireTypeMoteur(valeur, parametres.moteur)) {
+                cerr << "Erreur : moteur inconnu : " << valeur << endl;
+                return false;
+            }
+        }
+        else if (option == "--regle") {
+            if (!RegleVie::lire(valeur, parametres.regle)) {
+                cerr << "Erreur : regle invalide (attendu B.../S..., sans B0) : " << valeur << endl;
+                return false;
+            }
+            parametres.regleImposee = true;
+        }
+        else if (option == "--iterations" && numerique) parametres.iterations = (int)nombre;
+        else if (option == "--saut" && numerique) parametres.saut = nombre;
+        else if (option == "--intervalle" && numerique) parametres.intervalleSauvegarde = (int)nombre;
+        else if (option == "--pas" && numerique && nombre > 0) parametres.pasAvance = (int)nombre;
+        else if (option == "--par-image" && numerique) parametres.generationsParImage = (int)nombre;
+        else if (option == "--pixels" && numerique && nombre > 0) parametres.pixelSize = (int)nombre;
+        else if (option == "--threads" && numerique) parametres.nbThreads = (int)nombre;
+        else if (option == "--profondeur" && numerique && nombre >= 1 && nombre <= 64) parametres.profondeur = (int)nombre;
+        else if (option == "--densite" && numerique && nombre <= 100) parametres.densite = nombre / 100.0;
+        else if (option == "--graine" && numerique) parametres.graine = (unsigned long long)nombre;
+        else if (option == "--images-cles" && numerique && nombre > 0) parametres.intervalleCles = (int)nombre;
+        else if (option == "--exporter") parametres.archiveExport = valeur;
+        else if (option == "--mesures") {
+            parametres.fichierMesures = valeur;
+            parametres.mesuresJson = valeur.size() >= 5 && valeur.compare(valeur.size() - 5, 5, ".json") == 0;
+        }
+        else if (option == "--mesures-intervalle" && numerique && nombre > 0) parametres.intervalleMesures = (int)nombre;
+        else if (option == "--reprise" && numerique) parametres.intervalleReprise = (int)nombre;
+        else if (option == "--reprise-secondes" && numerique) parametres.secondesReprise = (int)nombre;
+        else if (option == "--file" && numerique) parametres.capaciteFile = (int)nombre;
+        else if (option == "--file-pleine") {
+            if (valeur == "bloquer") parametres.politique = PolitiqueFile::Bloquer;
+            else if (valeur == "abandonner") parametres.politique = PolitiqueFile::Abandonner;
+            else {
+                cerr << "Erreur : politique inconnue : " << valeur << endl;
+                return false;
+            }
+        }
+        else if (option == "--format") {
+            if (valeur == "texte") parametres.format = FormatSortie::Texte;
+            else if (valeur == "archive") parametres.format = FormatSortie::Archive;
+            else if (valeur == "statistiques") {
+                parametres.format = FormatSortie::Statistiques;
+                parametres.statistiques = true;
+            }
+            else {
+                cerr << "Erreur : format inconnu : " << valeur << endl;
+                return false;
+            }
+        }
+        else if (option == "--generations") {
+            size_t tiret = valeur.find('-');
+            long long debut = 0, fin = 0;
+            bool valide = tiret == string::npos ? lireEntier(valeur, debut) && lireEntier(valeur, fin)
+                                                : lireEntier(valeur.substr(0, tiret), debut) && lireEntier(valeur.substr(tiret + 1), fin);
+            if (!valide || fin < debut) {
+                cerr << "Erreur : generations invalides (attendu N ou A-B) : " << valeur << endl;
+                return false;
+            }
+            parametres.exportDebut = debut;
+            parametres.exportFin = fin;
+        }
+        else if (option == "--aleatoire" || option == "--taille") {
+            size_t x = valeur.find('x');
+            long long lignes = 0, colonnes = 0;
+            if (x == string::npos || !lireEntier(valeur.substr(0, x), lignes) || !lireEntier(valeur.substr(x + 1), colonnes)
+                || lignes <= 0 || colonnes <= 0) {
+                cerr << "Erreur : dimensions invalides (attendu LxC) : " << valeur << endl;
+                return false;
+            }
+            (option == "--taille" ? parametres.lignesMin : parametres.aleatoireLignes) = (int)lignes;
+            (option == "--taille" ? parametres.colonnesMin : parametres.aleatoireColonnes) = (int)colonnes;
+        }
+        else {
+            cerr << "Erreur : option ou valeur invalide : " << option << " " << valeur << endl;
+            return false;
+        }
+    }
+    if (parametres.reprendre && parametres.dossierSortie.empty()) {
+        cerr << "Erreur : --reprendre demande le dossier --sortie de la simulation interrompue" << endl;
+        return false;
+    }
+    if (parametres.fichier.empty() && parametres.aleatoireLignes == 0 && parametres.archiveExport.empty() && !parametres.reprendre) {
+        cerr << "Erreur : aucun fichier d'entree" << endl;
+        return false;
+    }
+    return true;
+}
+
+ParametresCourse extraireCourse(const Parametres& parametres) {
+    ParametresCourse course;
+    course.moteur = parametres.moteur;
+    course.iterations = parametres.iterations;
+    course.format = parametres.format;
+    course.intervalleSauvegarde = parametres.intervalleSauvegarde;
+    course.intervalleCles = parametres.intervalleCles;
+    course.statistiques = parametres.statistiques;
+    course.detectionCycles = parametres.detectionCycles;
+    return course;
+}
+
+bool reprendreCourse(Parametres& parametres, const ParametresCourse& course) {
+    auto donnee = [&](const char* option) {
+        return find(parametres.options.begin(), parametres.options.end(), option) != parametres.options.end();
+    };
+    const char* conflit = nullptr;
+    if (donnee("--moteur") && parametres.moteur != course.moteur) conflit = "--moteur";
+    else if (donnee("--format") && parametres.format != course.format) conflit = "--format";
+    else if (donnee("--intervalle") && parametres.intervalleSauvegarde != course.intervalleSauvegarde) conflit = "--intervalle";
+    else if (donnee("--images-cles") && parametres.intervalleCles != course.intervalleCles) conflit = "--images-cles";
+    else if (parametres.statistiques && !course.statistiques) conflit = "--statistiques";
+    else if (!parametres.detectionCycles && course.detectionCycles) conflit = "--sans-cycle";
+    if (conflit) {
+        cerr << "Erreur : " << conflit << " ne correspond pas au point de reprise (omettre l'option pour reprendre sa valeur)" << endl;
+        return false;
+    }
+    parametres.moteur = course.moteur;
+    if (!donnee("--iterations")) parametres.iterations = course.iterations;
+    parametres.format = course.format;
+    parametres.intervalleSauvegarde = course.intervalleSauvegarde;
+    parametres.intervalleCles = course.intervalleCles;
+    parametres.statistiques = course.statistiques;
+    parametres.detectionCycles = course.detectionCycles;
+    return true;
+}
+
+void demanderParametres(Parametres& parametres) {
+    string nomMoteur; // Moteur de calcul (creux, dense ou hashlife)
+
+    // Demande les paramètres à l'utilisateur
+    cout << "Entrez le NOM du fichier d'entree : ";
+    cin >> parametres.fichier;
+    cout << "Entrez le nombre d'iterations : ";
+    cin >> parametres.iterations;
+    cout << "Entrez la taille des pixels (ex : 20) : ";
+    cin >> parametres.pixelSize;
+    cout << "Entrez le moteur de calcul (creux/dense/hashlife/hybride/parallele/plan/table) : ";
+    cin >> nomMoteur;
+    if (!lireTypeMoteur(nomMoteur, parametres.moteur)) {
+        cout << "Moteur inconnu : " << nomMoteur << endl;
+        exit(1);
+    }
+    if (parametres.moteur == TypeMoteur::Hashlife) {
+        cout << "Entrez la generation a atteindre directement (0 = aucune) : ";
+        cin >> parametres.saut;
+    }
+}
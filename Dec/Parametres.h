@@ -0,0 +1,75 @@
+#ifndef PARAMETRES_H
+#define PARAMETRES_H
+
+#include <string>
+#include <vector>
+#include "Moteur.h"
+#include "RegleVie.h"
+
+// Format des itérations sauvegardées
+enum class FormatSortie { Texte, Archive, Statistiques }; // Statistiques : flux de statistiques seul, aucune grille
+
+// Comportement de l'écriture asynchrone quand la file des itérations à sauvegarder est pleine
+enum class PolitiqueFile { Bloquer, Abandonner };
+
+// Paramètres d'une simulation, lus sur la ligne de commande ou demandés à l'utilisateur
+struct Parametres {
+    std::string fichier;                    // Fichier de configuration initiale
+    int iterations = 100;                   // Nombre maximal d'itérations
+    int pixelSize = 20;                     // Taille des cellules à l'écran
+    TypeMoteur moteur = TypeMoteur::Creux;  // Moteur de calcul
+    RegleVie regle = CONWAY;                // Règle B/S de l'automate
+    bool regleImposee = false;              // --regle donnée : prioritaire sur la règle d'un motif RLE
+    long long saut = 0;                     // Génération atteinte directement (0 = aucune)
+    bool sansFenetre = false;               // Mode de calcul sans affichage
+    int pasAvance = 1000;                   // Fenêtre : générations calculées par la touche N
+    int generationsParImage = 1;            // Fenêtre : générations au plus par image (0 = sans limite)
+    std::string dossierSortie;              // Dossier des fichiers produits (vide = <nom>_<n>_out)
+    int intervalleSauvegarde = 1;           // Une itération sur N est sauvegardée (0 = aucune)
+    int nbThreads = 0;                      // Threads du moteur parallèle (0 = défaut d'OpenMP)
+    int lignesMin = 0;                      // Tore minimal autour d'un motif RLE ou .cells (0 = taille du motif)
+    int colonnesMin = 0;
+    int aleatoireLignes = 0;                // Dimensions d'une soupe aléatoire (0 = lecture du fichier)
+    int aleatoireColonnes = 0;
+    double densite = 0.5;                   // Proportion de cellules vivantes dans la soupe
+    unsigned long long graine = 1;          // Graine de la soupe aléatoire
+    bool detectionCycles = true;            // Faux : aucune détection de répétition
+    FormatSortie format = FormatSortie::Archive; // Archive binaire unique ou un fichier texte par itération
+    int intervalleCles = 64;                // Archive : une image clé tous les N enregistrements
+    int capaciteFile = 16;                  // Itérations en attente d'écriture (0 = écriture synchrone)
+    PolitiqueFile politique = PolitiqueFile::Bloquer; // File pleine : attendre ou abandonner l'itération
+    std::string archiveExport;              // Archive à convertir au format texte (outil d'export)
+    long long exportDebut = 0;              // Générations exportées [exportDebut, exportFin]
+    long long exportFin = -1;               // -1 = jusqu'à la dernière
+    std::string fichierMesures;             // Instrumentation : fichier CSV ou JSON (vide = aucune mesure)
+    bool mesuresJson = false;               // Une ligne JSON par mesure au lieu du CSV
+    int intervalleMesures = 1;              // Une ligne toutes les N générations
+    bool compteursMateriel = false;         // Cycles, instructions et défauts de cache autour de l'étape
+    int intervalleReprise = 0;              // Un point de reprise toutes les N générations (0 = aucun)
+    int secondesReprise = 0;                // Un point de reprise toutes les S secondes (0 = aucun)
+    bool reprendre = false;                 // Repart du dernier point de reprise valide du dossier de sortie
+    bool statistiques = false;              // Flux statistiques.jdvs : population, naissances, morts, boîte englobante
+    int profondeur = 1;                     // Blocage temporel : générations par passage de la grille (1 = aucun)
+    std::vector<std::string> options;       // Options données sur la ligne de commande (--reprendre : comparées au point)
+};
+
+// Paramètres qui déterminent les fichiers produits : enregistrés dans chaque point de reprise
+struct ParametresCourse {
+    TypeMoteur moteur = TypeMoteur::Creux;
+    int iterations = 100;
+    FormatSortie format = FormatSortie::Archive;
+    int intervalleSauvegarde = 1;
+    int intervalleCles = 64;
+    bool statistiques = false;
+    bool detectionCycles = true;
+};
+
+bool lireArguments(int argc, char* argv[], Parametres& parametres); // Retourne false si la ligne de commande est invalide
+void demanderParametres(Parametres& parametres);                   // Dialogue interactif historique
+void afficherUsage(const std::string& programme);
+ParametresCourse extraireCourse(const Parametres& parametres);
+// --reprendre : reprend les paramètres du point absents de la ligne de commande ; false si une option les contredit
+// (seul --iterations peut changer, pour prolonger la simulation)
+bool reprendreCourse(Parametres& parametres, const ParametresCourse& course);
+
+#endif // PARAMETRES_H
@@ -0,0 +1,164 @@
+#include "PointReprise.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+static const size_t TAILLE_ENTETE_REPRISE = 24; // Magic, version, taille du contenu, somme de contrôle
+
+static uint64_t sommeControle(const uint8_t* octets, size_t taille) {
+    uint64_t somme = 1469598103934665603ULL; // FNV-1a 64 bits
+    for (size_t i = 0; i < taille; ++i) {
+        somme ^= octets[i];
+        somme *= 1099511628211ULL;
+    }
+    return somme;
+}
+
+// Génération d'un fichier reprise_<génération>.jdvr (-1 pour un autre nom)
+static long long generationFichier(const fs::path& chemin) {
+    string nom = chemin.filename().string();
+    if (nom.rfind("reprise_", 0) != 0 || chemin.extension() != ".jdvr") return -1;
+    string nombre = nom.substr(8, nom.size() - 8 - 5);
+    if (nombre.empty() || nombre.find_first_not_of("0123456789") != string::npos) return -1;
+    return stoll(nombre);
+}
+
+// Points de reprise du dossier, du plus récent au plus ancien
+static vector<pair<long long, fs::path>> listerPoints(const string& dossier) {
+    vector<pair<long long, fs::path>> points;
+    error_code erreur;
+    for (const fs::directory_entry& entree : fs::directory_iterator(dossier, erreur)) {
+        long long generation = generationFichier(entree.path());
+        if (generation >= 0) points.emplace_back(generation, entree.path());
+    }
+    sort(points.begin(), points.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    return points;
+}
+
+// Écrit tout le tampon puis force son passage sur le disque
+static bool ecrireSynchrone(const string& chemin, const vector<uint8_t>& octets) {
+    int fd = open(chemin.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    size_t ecrits = 0;
+    while (ecrits < octets.size()) {
+        ssize_t n = write(fd, octets.data() + ecrits, octets.size() - ecrits);
+        if (n <= 0) {
+            close(fd);
+            return false;
+        }
+        ecrits += (size_t)n;
+    }
+    bool ok = fsync(fd) == 0;
+    return close(fd) == 0 && ok;
+}
+
+bool PointReprise::ecrire(const string& dossier, int conserves) const {
+    vector<uint8_t> contenu;
+    ecrireFixe<int64_t>(contenu, generation);
+    ecrireFixe<uint16_t>(contenu, regle.naissance);
+    ecrireFixe<uint16_t>(contenu, regle.survie);
+    contenu.push_back((uint8_t)course.moteur);
+    ecrireFixe<int32_t>(contenu, course.iterations);
+    contenu.push_back((uint8_t)course.format);
+    ecrireFixe<int32_t>(contenu, course.intervalleSauvegarde);
+    ecrireFixe<int32_t>(contenu, course.intervalleCles);
+    contenu.push_back(course.statistiques);
+    contenu.push_back(course.detectionCycles);
+    etat.serialiser(contenu);
+    historique.serialiser(contenu);
+    contenu.push_back(avecArchive);
+    if (avecArchive) {
+        ecrireFixe<uint64_t>(contenu, archive.taille);
+        ecrireFixe<int32_t>(contenu, archive.depuisCle);
+        archive.precedent.serialiser(contenu);
+        ecrireFixe<uint64_t>(contenu, archive.index.size());
+        for (const EntreeIndex& entree : archive.index) {
+            ecrireFixe<int64_t>(contenu, entree.generation);
+            ecrireFixe<uint64_t>(contenu, entree.position);
+            contenu.push_back(entree.type);
+        }
+    }
+
+    vector<uint8_t> octets;
+    octets.reserve(TAILLE_ENTETE_REPRISE + contenu.size());
+    for (char c : MAGIC_REPRISE) octets.push_back((uint8_t)c);
+    ecrireFixe<uint32_t>(octets, VERSION_REPRISE);
+    ecrireFixe<uint64_t>(octets, contenu.size());
+    ecrireFixe<uint64_t>(octets, sommeControle(contenu.data(), contenu.size()));
+    octets.insert(octets.end(), contenu.begin(), contenu.end());
+
+    // Nom temporaire puis renommage atomique ; le dossier est synchronisé pour que le nouveau nom survive
+    string temporaire = dossier + "/reprise.tmp";
+    string chemin = dossier + "/reprise_" + to_string(generation) + ".jdvr";
+    if (!ecrireSynchrone(temporaire, octets)) return false;
+    error_code erreur;
+    fs::rename(temporaire, chemin, erreur);
+    if (erreur) return false;
+    int fd = open(dossier.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+
+    vector<pair<long long, fs::path>> points = listerPoints(dossier);
+    for (size_t i = max(conserves, 1); i < points.size(); ++i) fs::remove(points[i].second, erreur);
+    return true;
+}
+
+bool PointReprise::lire(const string& chemin) {
+    ifstream fichier(chemin, ios::binary);
+    if (!fichier.is_open()) return false;
+    vector<uint8_t> octets((istreambuf_iterator<char>(fichier)), istreambuf_iterator<char>());
+    if (octets.size() < TAILLE_ENTETE_REPRISE || !equal(MAGIC_REPRISE, MAGIC_REPRISE + 4, (const char*)octets.data())
+        || lireFixe<uint32_t>(octets.data() + 4) != VERSION_REPRISE) return false;
+    uint64_t taille = lireFixe<uint64_t>(octets.data() + 8);
+    if (taille != octets.size() - TAILLE_ENTETE_REPRISE
+        || lireFixe<uint64_t>(octets.data() + 16) != sommeControle(octets.data() + TAILLE_ENTETE_REPRISE, taille)) return false;
+
+    const uint8_t* debut = octets.data() + TAILLE_ENTETE_REPRISE;
+    const uint8_t* fin = octets.data() + octets.size();
+    int64_t lue;
+    uint64_t nombre;
+    uint8_t moteur, format, statistiques, detectionCycles;
+    if (!lireFixe(debut, fin, lue) || !lireFixe(debut, fin, regle.naissance) || !lireFixe(debut, fin, regle.survie)
+        || !lireFixe(debut, fin, moteur) || !lireFixe(debut, fin, course.iterations) || !lireFixe(debut, fin, format)
+        || !lireFixe(debut, fin, course.intervalleSauvegarde) || !lireFixe(debut, fin, course.intervalleCles)
+        || !lireFixe(debut, fin, statistiques) || !lireFixe(debut, fin, detectionCycles)
+        || moteur > (uint8_t)TypeMoteur::Hybride || format > (uint8_t)FormatSortie::Statistiques
+        || !etat.restaurer(debut, fin) || !historique.restaurer(debut, fin)) return false;
+    generation = lue;
+    course.moteur = (TypeMoteur)moteur;
+    course.format = (FormatSortie)format;
+    course.statistiques = statistiques != 0;
+    course.detectionCycles = detectionCycles != 0;
+    if (debut >= fin) return false;
+    avecArchive = *debut++ != 0;
+    archive.index.clear();
+    if (avecArchive) {
+        if (!lireFixe(debut, fin, archive.taille) || !lireFixe(debut, fin, archive.depuisCle)
+            || !archive.precedent.restaurer(debut, fin) || !lireFixe(debut, fin, nombre)) return false;
+        for (uint64_t i = 0; i < nombre; ++i) {
+            EntreeIndex entree;
+            int64_t generationEntree;
+            if (!lireFixe(debut, fin, generationEntree) || !lireFixe(debut, fin, entree.position)
+                || !lireFixe(debut, fin, entree.type)) return false;
+            entree.generation = generationEntree;
+            archive.index.push_back(entree);
+        }
+    }
+    return debut == fin;
+}
+
+bool PointReprise::chercher(const string& dossier, PointReprise& point) {
+    for (const auto& [generation, chemin] : listerPoints(dossier)) {
+        if (point.lire(chemin.string())) return true;
+        cerr << "Attention : point de reprise invalide ignore : " << chemin.string() << endl;
+    }
+    return false;
+}
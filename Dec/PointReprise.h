@@ -0,0 +1,34 @@
+#ifndef POINTREPRISE_H
+#define POINTREPRISE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "GrilleBits.h"
+#include "RegleVie.h"
+#include "ArchiveRun.h"
+#include "DetecteurCycle.h"
+#include "Parametres.h"
+
+// Point de reprise d'une simulation longue : génération atteinte, règle, paramètres de course, grille du moteur, historique de la
+// détection de cycles et, pour le format archive, l'état d'écriture de simulation.jdv.
+// Fichier reprise_<génération>.jdvr : "JDVR", version, taille du contenu, somme de contrôle FNV-1a, contenu.
+// Il est écrit sous un nom temporaire puis renommé : un arrêt brutal laisse toujours l'ancien point intact.
+const char MAGIC_REPRISE[4] = {'J', 'D', 'V', 'R'};
+const uint32_t VERSION_REPRISE = 3;
+
+struct PointReprise {
+    long long generation = 0;
+    RegleVie regle;
+    ParametresCourse course; // Moteur, itérations, sorties : repris par --reprendre
+    GrilleBits etat;
+    HistoriqueCycles historique; // Blocs partagés avec le détecteur, encodés seulement à l'écriture
+    bool avecArchive = false;
+    EtatArchive archive;
+
+    bool ecrire(const std::string& dossier, int conserves = 2) const; // Ne garde que les derniers points du dossier
+    bool lire(const std::string& chemin);                              // Faux si le fichier est tronqué ou corrompu
+    static bool chercher(const std::string& dossier, PointReprise& point); // Point valide le plus récent du dossier
+};
+
+#endif // POINTREPRISE_H
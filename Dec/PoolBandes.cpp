@@ -0,0 +1,161 @@
+#include "PoolBandes.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <string>
+#ifdef __linux__
+#include <climits>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+namespace {
+
+const int ATTENTE_ACTIVE = 2000; // Tours d'attente active avant de s'endormir
+
+int nombreCoeurs() { return (int)std::max(1u, std::thread::hardware_concurrency()); }
+
+int nombreTravailleurs(int demandes) { return demandes > 0 ? demandes : nombreCoeurs(); }
+
+// Le thread appelant attend aussi : au-delà des coeurs, l'attente active prendrait le coeur d'un travailleur
+int toursActifs(int demandes) { return nombreTravailleurs(demandes) + 1 > nombreCoeurs() ? 0 : ATTENTE_ACTIVE; }
+
+void patienter() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// Nœud NUMA d'un coeur : lien nodeN du répertoire du coeur dans sysfs
+int noeudCoeur(int coeur) {
+    std::error_code erreur;
+    std::filesystem::directory_iterator entrees("/sys/devices/system/cpu/cpu" + std::to_string(coeur), erreur);
+    if (erreur) return 0;
+    for (const auto& entree : entrees) {
+        const std::string nom = entree.path().filename().string();
+        if (nom.size() > 4 && nom.compare(0, 4, "node") == 0 && std::all_of(nom.begin() + 4, nom.end(), ::isdigit)) {
+            return std::stoi(nom.substr(4));
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+BarriereAttente::BarriereAttente(int participants, int toursActifs)
+    : participants(participants), toursActifs(toursActifs), arrives(0), phase(0), endormis(0) {}
+
+void BarriereAttente::attendre() {
+    const uint32_t courante = phase.load(std::memory_order_acquire);
+    if (arrives.fetch_add(1, std::memory_order_acq_rel) + 1 == participants) {
+        arrives.store(0, std::memory_order_relaxed);
+        phase.fetch_add(1); // Ordre séquentiel : vu avant la lecture de endormis
+#ifdef __linux__
+        if (endormis.load()) syscall(SYS_futex, (uint32_t*)&phase, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+        return;
+    }
+    for (int tour = 0; tour < toursActifs; ++tour) {
+        if (phase.load(std::memory_order_acquire) != courante) return;
+        patienter();
+    }
+    while (phase.load(std::memory_order_acquire) == courante) {
+#ifdef __linux__
+        endormis.fetch_add(1);
+        if (phase.load() == courante) { // Le noyau revérifie la phase avant d'endormir le thread
+            syscall(SYS_futex, (uint32_t*)&phase, FUTEX_WAIT_PRIVATE, courante, nullptr, nullptr, 0);
+        }
+        endormis.fetch_sub(1);
+#else
+        std::this_thread::yield();
+#endif
+    }
+}
+
+PoolBandes::PoolBandes(int nbTravailleurs)
+    : nbTravailleurs(nombreTravailleurs(nbTravailleurs)), nbNoeuds(1), tache(nullptr), contexte(nullptr), arret(false),
+      depart(this->nbTravailleurs + 1, toursActifs(nbTravailleurs)), arrivee(this->nbTravailleurs + 1, toursActifs(nbTravailleurs)) {
+    const int n = this->nbTravailleurs;
+    std::vector<std::pair<int, int>> disponibles; // (nœud, coeur) des coeurs autorisés
+#ifdef __linux__
+    cpu_set_t autorises;
+    CPU_ZERO(&autorises);
+    if (sched_getaffinity(0, sizeof(autorises), &autorises) == 0) {
+        for (int coeur = 0; coeur < CPU_SETSIZE; ++coeur) {
+            if (CPU_ISSET(coeur, &autorises)) disponibles.push_back({noeudCoeur(coeur), coeur});
+        }
+    }
+#endif
+    std::sort(disponibles.begin(), disponibles.end());
+    for (int t = 0; t < n; ++t) {
+        if (disponibles.empty()) {
+            coeurs.push_back(-1); // Placement laissé au système
+            noeuds.push_back(0);
+        } else {
+            coeurs.push_back(disponibles[t % disponibles.size()].second);
+            noeuds.push_back(disponibles[t % disponibles.size()].first);
+        }
+    }
+    nbNoeuds = *std::max_element(noeuds.begin(), noeuds.end()) + 1;
+
+    for (int t = 0; t < n && n > 1; ++t) {
+        threads.emplace_back(&PoolBandes::boucle, this, t);
+#ifdef __linux__
+        if (coeurs[t] >= 0) {
+            cpu_set_t coeur;
+            CPU_ZERO(&coeur);
+            CPU_SET(coeurs[t], &coeur);
+            pthread_setaffinity_np(threads.back().native_handle(), sizeof(coeur), &coeur);
+        }
+#endif
+    }
+}
+
+PoolBandes::~PoolBandes() {
+    if (threads.empty()) return;
+    arret = true;
+    depart.attendre();
+    for (std::thread& thread : threads) thread.join();
+}
+
+void PoolBandes::boucle(int travailleur) {
+    while (true) {
+        depart.attendre();
+        if (arret) return;
+        tache(contexte, travailleur);
+        arrivee.attendre();
+    }
+}
+
+void PoolBandes::lancer(void (*nouvelle)(const void*, int), const void* nouveauContexte) {
+    if (threads.empty()) {
+        nouvelle(nouveauContexte, 0);
+        return;
+    }
+    tache = nouvelle;
+    contexte = nouveauContexte;
+    depart.attendre();
+    arrivee.attendre();
+}
+
+int PoolBandes::getNbTravailleurs() const { return nbTravailleurs; }
+int PoolBandes::getNbNoeuds() const { return nbNoeuds; }
+int PoolBandes::noeud(int travailleur) const { return noeuds[travailleur]; }
+
+void PoolBandes::replacerPages(void* debut, std::size_t taille) {
+#ifdef __linux__
+    const uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    const uintptr_t premiere = ((uintptr_t)debut + page - 1) / page * page;
+    const uintptr_t fin = ((uintptr_t)debut + taille) / page * page;
+    if (fin > premiere) madvise((void*)premiere, fin - premiere, MADV_DONTNEED);
+#else
+    (void)debut;
+    (void)taille;
+#endif
+}
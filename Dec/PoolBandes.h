@@ -0,0 +1,63 @@
+#ifndef POOLBANDES_H
+#define POOLBANDES_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Barrière réutilisable : attente active brève, puis sommeil sur un futex (Linux) jusqu'au dernier arrivé.
+// Le dernier n'appelle le noyau que si un participant s'est endormi.
+class BarriereAttente {
+public:
+    BarriereAttente(int participants, int toursActifs); // toursActifs : 0 si les participants dépassent les coeurs
+    void attendre();
+
+private:
+    const int participants, toursActifs;
+    std::atomic<int> arrives;
+    std::atomic<uint32_t> phase;    // Incrémentée par le dernier arrivé
+    std::atomic<int> endormis;
+};
+
+// Travailleurs persistants, chacun fixé sur un coeur : les coeurs autorisés au processus sont pris nœud NUMA
+// par nœud NUMA, de sorte que des travailleurs voisins (des bandes voisines) partagent le même socket.
+// executer lance la tâche sur tous les travailleurs et retourne quand tous ont fini : deux barrières,
+// sans création de thread ni région parallèle par appel. Un seul travailleur : la tâche s'exécute directement
+// sur le thread appelant.
+class PoolBandes {
+public:
+    explicit PoolBandes(int nbTravailleurs = 0); // 0 = nombre de coeurs
+    ~PoolBandes();
+    PoolBandes(const PoolBandes&) = delete;
+    PoolBandes& operator=(const PoolBandes&) = delete;
+
+    // fonction(travailleur) sur chaque travailleur ; aucune copie ni allocation de la fonction
+    template <typename Fonction>
+    void executer(const Fonction& fonction) {
+        lancer([](const void* contexte, int travailleur) { (*(const Fonction*)contexte)(travailleur); }, &fonction);
+    }
+    int getNbTravailleurs() const;
+    int getNbNoeuds() const;
+    int noeud(int travailleur) const; // Nœud NUMA du coeur du travailleur (0 si inconnu)
+
+    // Rend au système les pages entièrement contenues dans [debut, debut + taille) : le prochain accès,
+    // fait par le travailleur qui remplit sa bande, les alloue sur son propre nœud (premier contact)
+    static void replacerPages(void* debut, std::size_t taille);
+
+private:
+    const int nbTravailleurs;
+    std::vector<std::thread> threads; // Vide pour un seul travailleur
+    std::vector<int> coeurs, noeuds;  // Par travailleur
+    int nbNoeuds;
+    void (*tache)(const void*, int); // Tâche en cours, publiée par la barrière de départ
+    const void* contexte;
+    bool arret;
+    BarriereAttente depart, arrivee; // Travailleurs et thread appelant
+
+    void boucle(int travailleur);
+    void lancer(void (*nouvelle)(const void*, int), const void* nouveauContexte);
+};
+
+#endif // POOLBANDES_H
@@ -0,0 +1,80 @@
+#include "PoolVolTaches.h"
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+// Tranche d'indices restant à traiter par un thread
+struct Tranche {
+    std::mutex verrou;
+    long long debut = 0, fin = 0;
+};
+
+} // namespace
+
+PoolVolTaches::PoolVolTaches(int nbThreads) : nbThreads(nbThreads), vols(0) {
+    if (this->nbThreads <= 0) this->nbThreads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+int PoolVolTaches::getNbThreads() const { return nbThreads; }
+long long PoolVolTaches::getVols() const { return vols; }
+
+void PoolVolTaches::executer(long long debut, long long fin, const Tache& tache) {
+    const int n = nbThreads;
+    std::unique_ptr<Tranche[]> tranches(new Tranche[n]);
+    for (int t = 0; t < n; ++t) {
+        tranches[t].debut = debut + (fin - debut) * t / n;
+        tranches[t].fin = debut + (fin - debut) * (t + 1) / n;
+    }
+    std::atomic<long long> volees(0);
+
+    // Aucune tâche n'est ajoutée en cours de route : un thread qui ne trouve rien à voler chez aucun autre a
+    // fini, les tâches restantes seront traitées par les threads qui les détiennent. Il quitte la boucle au lieu
+    // d'attendre en boucle active les plus longues (la jonction des threads suffit à les attendre).
+    auto travailleur = [&](int t) {
+        Tranche& propre = tranches[t];
+        uint64_t alea = 0x9E3779B97F4A7C15ULL * (t + 1); // Choix de la première victime essayée
+        for (;;) {
+            long long indice = -1;
+            {
+                std::lock_guard<std::mutex> verrou(propre.verrou);
+                if (propre.debut < propre.fin) indice = propre.debut++;
+            }
+            if (indice >= 0) {
+                tache(t, indice);
+                continue;
+            }
+            // Vol : la seconde moitié de la tranche de la première victime trouvée, à partir d'un thread tiré au hasard
+            alea ^= alea << 13; alea ^= alea >> 7; alea ^= alea << 17;
+            long long volDebut = 0, volFin = 0;
+            const int premiere = (int)(alea % n);
+            for (int essai = 0; essai < n && volDebut == volFin; ++essai) {
+                const int victime = (premiere + essai) % n;
+                if (victime == t) continue;
+                Tranche& autre = tranches[victime];
+                std::lock_guard<std::mutex> verrou(autre.verrou);
+                if (autre.fin - autre.debut >= 2) {
+                    volDebut = autre.debut + (autre.fin - autre.debut) / 2;
+                    volFin = autre.fin;
+                    autre.fin = volDebut;
+                }
+            }
+            if (volDebut == volFin) return; // Plus rien à voler
+            std::lock_guard<std::mutex> verrou(propre.verrou);
+            propre.debut = volDebut;
+            propre.fin = volFin;
+            volees.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < n; ++t) threads.emplace_back(travailleur, t);
+    travailleur(0); // Le thread appelant travaille aussi
+    for (std::thread& thread : threads) thread.join();
+    vols = volees.load();
+}
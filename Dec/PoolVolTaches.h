@@ -0,0 +1,24 @@
+#ifndef POOLVOLTACHES_H
+#define POOLVOLTACHES_H
+
+#include <functional>
+
+// Exécute une tâche par indice de [debut, fin) sur plusieurs threads, avec vol de travail :
+// chaque thread reçoit une tranche contiguë d'indices et la consomme par l'avant ; un thread
+// sans travail prend la seconde moitié de la tranche restante d'un autre thread.
+// Adapté aux tâches de durées très inégales (une soupe peut durer mille fois plus qu'une autre).
+class PoolVolTaches {
+public:
+    typedef std::function<void(int thread, long long indice)> Tache;
+
+    explicit PoolVolTaches(int nbThreads = 0); // 0 = nombre de coeurs
+    void executer(long long debut, long long fin, const Tache& tache); // Retourne quand toutes les tâches sont finies
+    int getNbThreads() const;
+    long long getVols() const; // Tranches volées lors du dernier appel
+
+private:
+    int nbThreads;
+    long long vols;
+};
+
+#endif // POOLVOLTACHES_H
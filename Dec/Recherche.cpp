@@ -0,0 +1,68 @@
+// Recherche de soupes : simule un intervalle de graines sans affichage et ajoute, pour chaque soupe,
+// la génération de stabilisation, la période et la population finale à un fichier CSV.
+#include <iostream>
+#include <string>
+#include "RechercheSoupes.h"
+
+using namespace std;
+
+static void afficherUsageRecherche(const string& programme) {
+    cout << "Usage : " << programme << " [options]\n"
+         << "  --graines A-B      graines simulees, A incluse, B exclue (defaut 1-1001)\n"
+         << "  --taille LxC       tore de chaque soupe (defaut 128x128)\n"
+         << "  --densite P        pourcentage de cellules vivantes (defaut 50)\n"
+         << "  --iterations N     generations au-dela desquelles la soupe est notee non stabilisee (defaut 100000)\n"
+         << "  --moteur NOM       creux, dense, hashlife, hybride, plan, table (defaut dense)\n"
+         << "  --regle R          regle B/S ou nom (defaut B3/S23)\n"
+         << "  --threads N        threads de calcul (defaut : tous les coeurs)\n"
+         << "  --sortie FICHIER   resultats ajoutes en fin de fichier (defaut soupes.csv)\n"
+         << "  --aide             affiche ce message" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    ParametresRecherche parametres;
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--aide" || i + 1 >= argc) {
+            afficherUsageRecherche(argv[0]);
+            return option == "--aide" ? 0 : 1;
+        }
+        string valeur = argv[++i];
+        bool valide = true;
+        try {
+            if (option == "--graines") {
+                size_t tiret = valeur.find('-');
+                parametres.graineDebut = stoull(valeur.substr(0, tiret));
+                parametres.graineFin = tiret == string::npos ? parametres.graineDebut + 1 : stoull(valeur.substr(tiret + 1));
+                valide = parametres.graineFin > parametres.graineDebut;
+            }
+            else if (option == "--taille") {
+                size_t x = valeur.find('x');
+                parametres.lignes = stoi(valeur.substr(0, x));
+                parametres.colonnes = x == string::npos ? parametres.lignes : stoi(valeur.substr(x + 1));
+                valide = parametres.lignes > 0 && parametres.colonnes > 0;
+            }
+            else if (option == "--densite") {
+                parametres.densite = stod(valeur) / 100.0;
+                valide = parametres.densite >= 0 && parametres.densite <= 1;
+            }
+            else if (option == "--iterations") parametres.iterationsMax = stoi(valeur);
+            else if (option == "--moteur") valide = lireTypeMoteur(valeur, parametres.moteur);
+            else if (option == "--regle") valide = RegleVie::lire(valeur, parametres.regle);
+            else if (option == "--threads") parametres.nbThreads = stoi(valeur);
+            else if (option == "--sortie") parametres.fichier = valeur;
+            else valide = false;
+        } catch (...) {
+            valide = false;
+        }
+        if (!valide) {
+            cerr << "Erreur : option ou valeur invalide : " << option << " " << valeur << endl;
+            afficherUsageRecherche(argv[0]);
+            return 1;
+        }
+    }
+
+    RechercheSoupes recherche(parametres);
+    recherche.executer();
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include "RechercheSoupes.h"
+#include "PoolVolTaches.h"
+#include "DetecteurCycle.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+using namespace std;
+
+namespace {
+
+// Générateur xoshiro256** initialisé par splitmix64 : rapide, 64 bits aléatoires par appel
+class Xoshiro {
+private:
+    uint64_t s[4];
+    static uint64_t rotation(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    explicit Xoshiro(uint64_t graine) {
+        for (uint64_t& mot : s) {
+            uint64_t z = (graine += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            mot = z ^ (z >> 31);
+        }
+    }
+    uint64_t operator()() {
+        const uint64_t resultat = rotation(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotation(s[3], 45);
+        return resultat;
+    }
+};
+
+// Simule une soupe jusqu'à la répétition d'une configuration ou jusqu'à iterationsMax
+ResultatSoupe simuler(Moteur& moteur, DetecteurCycle& detecteur, std::vector<uint64_t>& changements,
+                      const GrilleBits& soupe, int iterationsMax) {
+    ResultatSoupe resultat;
+    moteur.charger(soupe);
+    detecteur.initialiser(soupe);
+    for (int generation = 1; generation <= iterationsMax; ++generation) {
+        moteur.etape();
+        moteur.cellulesChangees(changements);
+        if (detecteur.enregistrer(changements, moteur)) {
+            resultat.stabilisee = true;
+            resultat.generation = generation;
+            resultat.periode = detecteur.getPeriode();
+            break;
+        }
+    }
+    if (!resultat.stabilisee) resultat.generation = iterationsMax;
+    resultat.population = moteur.population();
+    return resultat;
+}
+
+} // namespace
+
+RechercheSoupes::RechercheSoupes(const ParametresRecherche& parametres) : parametres(parametres) {}
+
+// 64 cellules par tirage : la densité est approchée à 2^-16 près en combinant 16 mots aléatoires
+// (bit de densité à 1 : OU, à 0 : ET), une seule combinaison pour une densité de 50 %
+void RechercheSoupes::remplirLigne(uint64_t* ligne, int colonnes, double densite, uint64_t graine, long long x) {
+    Xoshiro aleatoire(graine * 0xD1342543DE82EF95ULL + (uint64_t)x);
+    const uint32_t seuil = (uint32_t)std::lround(std::min(1.0, std::max(0.0, densite)) * 65536);
+    const int mots = (colonnes + 63) / 64;
+    const uint64_t masque = colonnes % 64 == 0 ? ~0ULL : (1ULL << (colonnes % 64)) - 1;
+    for (int k = 0; k < mots; ++k) {
+        uint64_t mot = 0;
+        if (seuil >= 65536) mot = ~0ULL;
+        else if (seuil > 0) {
+            for (int bit = __builtin_ctz(seuil); bit < 16; ++bit) {
+                mot = ((seuil >> bit) & 1) ? (mot | aleatoire()) : (mot & aleatoire());
+            }
+        }
+        ligne[k] = k == mots - 1 ? mot & masque : mot;
+    }
+}
+
+void RechercheSoupes::remplirSoupe(GrilleBits& etat, int lignes, int colonnes, double densite, uint64_t graine) {
+    etat.redimensionner(lignes, colonnes);
+    for (int x = 0; x < lignes; ++x) remplirLigne(etat.ligne(x), colonnes, densite, graine, x);
+}
+
+void RechercheSoupes::executer() {
+    ofstream fichier(parametres.fichier, ios::app);
+    if (!fichier.is_open()) {
+        cerr << "Erreur : Impossible d'ouvrir " << parametres.fichier << endl;
+        exit(1);
+    }
+    if (fichier.tellp() == 0) fichier << "graine,lignes,colonnes,densite,regle,stabilisee,generation,periode,population" << endl;
+
+    PoolVolTaches pool(parametres.nbThreads);
+    const int nbThreads = pool.getNbThreads();
+
+    // État propre à chaque thread : aucun partage pendant la simulation
+    struct Contexte {
+        unique_ptr<Moteur> moteur;
+        DetecteurCycle detecteur;
+        GrilleBits soupe;
+        vector<uint64_t> changements;
+        ostringstream lignes;
+        int enAttente = 0;
+        Contexte(size_t capacite) : detecteur(capacite) {}
+    };
+    vector<unique_ptr<Contexte>> contextes;
+    for (int t = 0; t < nbThreads; ++t) {
+        contextes.push_back(make_unique<Contexte>(min((size_t)parametres.iterationsMax + 1, (size_t)1 << 20)));
+        contextes[t]->moteur = creerMoteur(parametres.moteur, 1); // Le parallélisme est entre les soupes
+        contextes[t]->moteur->setRegle(parametres.regle);
+    }
+
+    mutex verrouFichier;
+    auto ecrire = [&](Contexte& contexte) {
+        lock_guard<mutex> verrou(verrouFichier);
+        fichier << contexte.lignes.str();
+        fichier.flush();
+        contexte.lignes.str("");
+        contexte.enAttente = 0;
+    };
+    const string regle = parametres.regle.texte();
+
+    auto debut = chrono::steady_clock::now();
+    pool.executer((long long)parametres.graineDebut, (long long)parametres.graineFin, [&](int t, long long indice) {
+        Contexte& contexte = *contextes[t];
+        remplirSoupe(contexte.soupe, parametres.lignes, parametres.colonnes, parametres.densite, (uint64_t)indice);
+        ResultatSoupe resultat = simuler(*contexte.moteur, contexte.detecteur, contexte.changements, contexte.soupe,
+                                         parametres.iterationsMax);
+        contexte.lignes << indice << "," << parametres.lignes << "," << parametres.colonnes << "," << parametres.densite << ","
+                        << regle << "," << resultat.stabilisee << "," << resultat.generation << "," << resultat.periode << ","
+                        << resultat.population << "\n";
+        if (++contexte.enAttente >= 64) ecrire(contexte); // Écriture par paquets : le verrou est rarement pris
+    });
+    for (auto& contexte : contextes) {
+        if (contexte->enAttente > 0) ecrire(*contexte);
+    }
+    double secondes = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+
+    long long soupes = (long long)(parametres.graineFin - parametres.graineDebut);
+    cout << soupes << " soupe(s) en " << fixed << setprecision(3) << secondes << " s sur " << nbThreads << " thread(s) : "
+         << setprecision(1) << (secondes > 0 ? soupes / secondes : 0.0) << " soupes/s (" << pool.getVols() << " vol(s))" << endl;
+    cout << "Resultats ajoutes a " << parametres.fichier << endl;
+}
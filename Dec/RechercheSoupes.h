@@ -0,0 +1,48 @@
+#ifndef RECHERCHESOUPES_H
+#define RECHERCHESOUPES_H
+
+#include <string>
+#include <cstdint>
+#include "Moteur.h"
+#include "RegleVie.h"
+#include "GrilleBits.h"
+
+// Paramètres d'une recherche de soupes
+struct ParametresRecherche {
+    uint64_t graineDebut = 1, graineFin = 1001;  // Graines [debut, fin)
+    int lignes = 128, colonnes = 128;            // Tore de chaque soupe
+    double densite = 0.5;                        // Probabilité qu'une cellule soit vivante
+    int iterationsMax = 100000;                  // Au-delà, la soupe est notée non stabilisée
+    TypeMoteur moteur = TypeMoteur::Dense;
+    RegleVie regle;                              // B3/S23 par défaut
+    int nbThreads = 0;                           // 0 = nombre de coeurs
+    std::string fichier = "soupes.csv";          // Résultats ajoutés en fin de fichier
+};
+
+// Résultat d'une soupe : génération et période du cycle atteint, population finale
+struct ResultatSoupe {
+    uint64_t graine = 0;
+    bool stabilisee = false;
+    int generation = 0; // Génération où la répétition est confirmée (ou iterationsMax)
+    int periode = 0;
+    long long population = 0;
+};
+
+// Recherche statistique : chaque graine donne une soupe aléatoire simulée jusqu'à stabilisation.
+// Les soupes sont réparties une par tâche sur un pool à vol de travail, chaque thread gardant son moteur
+// et son détecteur de cycles ; les résultats sont ajoutés au fichier CSV par paquets.
+class RechercheSoupes {
+private:
+    ParametresRecherche parametres;
+
+public:
+    explicit RechercheSoupes(const ParametresRecherche& parametres);
+    void executer(); // Simule toutes les graines et affiche le débit (soupes/s)
+
+    // Soupe reproductible : même graine, mêmes dimensions et même densité donnent la même grille.
+    // Chaque ligne a son propre générateur : un sous-ensemble de lignes peut être produit seul (découpage MPI).
+    static void remplirSoupe(GrilleBits& etat, int lignes, int colonnes, double densite, uint64_t graine);
+    static void remplirLigne(uint64_t* ligne, int colonnes, double densite, uint64_t graine, long long x);
+};
+
+#endif // RECHERCHESOUPES_H
@@ -6,3 +6,9 @@ bool RegleSt::application(bool etat, int nombreDeVoisins) const {
     return false;
 }
 
+
+RegleBS::RegleBS(const RegleVie& regle) : regle(regle) {}
+
+bool RegleBS::application(bool etat, int nombreDeVoisins) const {
+    return regle.application(etat, nombreDeVoisins);
+}
@@ -1,8 +1,13 @@
 #ifndef REGLE_H
 #define REGLE_H
 
+#include "RegleVie.h"
+
+// Règle définie par l'utilisateur (appel virtuel par cellule).
+// Les moteurs n'appellent pas application : ils utilisent la table RegleVie::depuis(regle).
 class Regle {
 public:
+    virtual ~Regle() = default;
     virtual bool application(bool etat, int nombreDeVoisins) const = 0;
 };
 
@@ -11,5 +16,14 @@ public:
     bool application(bool etat, int nombreDeVoisins) const override;
 };
 
-#endif // REGLE_H
+// Adaptateur : une règle B/S vue à travers l'interface Regle
+class RegleBS : public Regle {
+private:
+    RegleVie regle;
 
+public:
+    RegleBS(const RegleVie& regle = CONWAY);
+    bool application(bool etat, int nombreDeVoisins) const override;
+};
+
+#endif // REGLE_H
@@ -0,0 +1,77 @@
+#include "RegleVie.h"
+#include "Regle.h"
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+// Règles désignées par leur nom
+static const struct { const char* nom; RegleVie regle; } REGLES_NOMMEES[] = {
+    {"conway", CONWAY}, {"life", CONWAY}, {"highlife", HIGHLIFE}, {"daynight", DAY_AND_NIGHT},
+    {"seeds", SEEDS}, {"lwod", LIFE_WITHOUT_DEATH}, {"maze", MAZE}, {"replicator", REPLICATOR},
+    {"2x2", DEUX_PAR_DEUX},
+};
+
+string RegleVie::texte() const {
+    string s = "B";
+    for (int n = 0; n <= 8; ++n) if ((naissance >> n) & 1) s += char('0' + n);
+    s += "/S";
+    for (int n = 0; n <= 8; ++n) if ((survie >> n) & 1) s += char('0' + n);
+    return s;
+}
+
+// Lit une suite de chiffres 0 à 8 ; faux si un chiffre est répété ou invalide
+static bool lireChiffres(const string& texte, uint16_t& masque) {
+    masque = 0;
+    for (char c : texte) {
+        if (c < '0' || c > '8' || ((masque >> (c - '0')) & 1)) return false;
+        masque |= 1 << (c - '0');
+    }
+    return true;
+}
+
+bool RegleVie::lire(const string& texte, RegleVie& regle) {
+    string s;
+    for (char c : texte) s += (char)tolower((unsigned char)c);
+    for (const auto& nommee : REGLES_NOMMEES) {
+        if (s == nommee.nom) {
+            regle = nommee.regle;
+            return true;
+        }
+    }
+
+    size_t barre = s.find('/');
+    if (barre == string::npos) return false;
+    string gauche = s.substr(0, barre), droite = s.substr(barre + 1);
+    string b, survivants;
+    if (!gauche.empty() && gauche[0] == 'b' && (droite.empty() || droite[0] == 's')) { // B3/S23
+        b = gauche.substr(1);
+        survivants = droite.empty() ? "" : droite.substr(1);
+    } else if (!gauche.empty() && gauche[0] == 's' && !droite.empty() && droite[0] == 'b') { // S23/B3
+        survivants = gauche.substr(1);
+        b = droite.substr(1);
+    } else { // Notation historique S/B : "23/3"
+        survivants = gauche;
+        b = droite;
+    }
+
+    RegleVie lue(0, 0);
+    if (!lireChiffres(b, lue.naissance) || !lireChiffres(survivants, lue.survie)) return false;
+    if (lue.naissance & 1) return false; // B0 : non pris en charge
+    regle = lue;
+    return true;
+}
+
+RegleVie RegleVie::depuis(const Regle& regle) {
+    RegleVie table(0, 0);
+    for (int n = 0; n <= 8; ++n) {
+        if (regle.application(false, n)) table.naissance |= 1 << n;
+        if (regle.application(true, n)) table.survie |= 1 << n;
+    }
+    if (table.naissance & 1) { // B0 : refusée comme par lire
+        cerr << "Erreur : La regle " << table.texte() << " fait naitre une cellule sans voisine (B0), non prise en charge." << endl;
+        exit(1);
+    }
+    return table;
+}
@@ -0,0 +1,74 @@
+#ifndef REGLEVIE_H
+#define REGLEVIE_H
+
+#include <string>
+#include <cstdint>
+
+class Regle;
+
+// Règle d'un automate « Life-like » en notation B/S (ex. "B36/S23") compilée en table :
+// bit n de naissance (resp. survie) = une cellule morte (resp. vivante) avec n voisines est vivante ensuite.
+// Les règles B0 (naissance sans voisine) ne sont pas acceptées : une région vide doit rester vide.
+struct RegleVie {
+    uint16_t naissance;
+    uint16_t survie;
+
+    constexpr RegleVie(uint16_t naissance = 1 << 3, uint16_t survie = (1 << 2) | (1 << 3))
+        : naissance(naissance), survie(survie) {}
+
+    bool application(bool etat, int nombreDeVoisins) const {
+        return ((etat ? survie : naissance) >> nombreDeVoisins) & 1;
+    }
+    std::string texte() const; // Forme canonique "B.../S..."
+
+    static bool lire(const std::string& texte, RegleVie& regle); // Notation B/S, S/B ("23/3") ou nom connu
+    static RegleVie depuis(const Regle& regle); // Table d'une règle définie par l'utilisateur
+
+    constexpr bool operator==(const RegleVie& other) const { return naissance == other.naissance && survie == other.survie; }
+    constexpr bool operator!=(const RegleVie& other) const { return !(*this == other); }
+};
+
+// Règles courantes, disponibles à la compilation
+constexpr RegleVie CONWAY(1 << 3, (1 << 2) | (1 << 3));                                               // B3/S23
+constexpr RegleVie HIGHLIFE((1 << 3) | (1 << 6), (1 << 2) | (1 << 3));                                // B36/S23
+constexpr RegleVie DAY_AND_NIGHT(0x1C8, 0x1D8);                                                       // B3678/S34678
+constexpr RegleVie SEEDS(1 << 2, 0);                                                                  // B2/S
+constexpr RegleVie LIFE_WITHOUT_DEATH(1 << 3, 0x1FF);                                                 // B3/S012345678
+constexpr RegleVie MAZE(1 << 3, 0x3E);                                                                // B3/S12345
+constexpr RegleVie REPLICATOR(0xAA, 0xAA);                                                            // B1357/S1357
+constexpr RegleVie DEUX_PAR_DEUX((1 << 3) | (1 << 6), (1 << 1) | (1 << 2) | (1 << 5));               // B36/S125
+
+// Cellules dont le nombre de voisines vaut n, le nombre étant donné en tranches de bits b0 + 2*b1 + 4*b2 + 8*b3
+template <typename Mot>
+inline Mot voisinesEgales(Mot b0, Mot b1, Mot b2, Mot b3, int n) {
+    return (n & 1 ? b0 : ~b0) & (n & 2 ? b1 : ~b1) & (n & 4 ? b2 : ~b2) & (n & 8 ? b3 : ~b3);
+}
+
+// Règle fixée à la compilation : la boucle est dépliée et réduite à quelques opérations par mot
+template <uint16_t Naissance, uint16_t Survie, typename Mot>
+inline Mot appliquerRegle(Mot b0, Mot b1, Mot b2, Mot b3, Mot vivantes) {
+    if constexpr (RegleVie(Naissance, Survie) == CONWAY) {
+        return ~b3 & ~b2 & b1 & (b0 | vivantes);
+    } else {
+        Mot nees{}, survivantes{};
+        for (int n = 0; n <= 8; ++n) {
+            if ((Naissance >> n) & 1) nees |= voisinesEgales(b0, b1, b2, b3, n);
+            if ((Survie >> n) & 1) survivantes |= voisinesEgales(b0, b1, b2, b3, n);
+        }
+        return (nees & ~vivantes) | (survivantes & vivantes);
+    }
+}
+
+// Règle connue seulement à l'exécution : même calcul, sans appel indirect
+template <typename Mot>
+inline Mot appliquerRegle(const RegleVie& regle, Mot b0, Mot b1, Mot b2, Mot b3, Mot vivantes) {
+    if (regle == CONWAY) return ~b3 & ~b2 & b1 & (b0 | vivantes);
+    Mot nees{}, survivantes{};
+    for (int n = 0; n <= 8; ++n) {
+        if ((regle.naissance >> n) & 1) nees |= voisinesEgales(b0, b1, b2, b3, n);
+        if ((regle.survie >> n) & 1) survivantes |= voisinesEgales(b0, b1, b2, b3, n);
+    }
+    return (nees & ~vivantes) | (survivantes & vivantes);
+}
+
+#endif // REGLEVIE_H
@@ -0,0 +1,65 @@
+#include "RenduGrille.h"
+#include <iostream>
+#include <cstring>
+
+using namespace std;
+
+static const uint32_t PIXEL_VIVANT = 0xFFFFFFFFu; // Blanc opaque (octets R, G, B, A)
+static const uint32_t PIXEL_MORT = 0xFF000000u;   // Noir opaque
+static const int MAX_ENVOIS_PAR_IMAGE = 32;       // Au-delà, un seul envoi couvre toutes les lignes modifiées
+
+RenduGrille::RenduGrille() : initialise(false) {}
+
+void RenduGrille::convertirLigne(const GrilleBits& etat, int x) {
+    const int nbColonnes = etat.getNbColonnes();
+    const uint64_t* mots = etat.ligne(x);
+    uint32_t* sortie = pixels.data() + (size_t)x * nbColonnes;
+    for (int k = 0; k < etat.getMotsParLigne(); ++k) {
+        uint64_t mot = mots[k];
+        int fin = min(64, nbColonnes - 64 * k);
+        for (int b = 0; b < fin; ++b) sortie[64 * k + b] = ((mot >> b) & 1) ? PIXEL_VIVANT : PIXEL_MORT;
+    }
+}
+
+void RenduGrille::dessiner(sf::RenderWindow& window, const GrilleBits& etat, int pixelSize) {
+    const int nbLignes = etat.getNbLignes(), nbColonnes = etat.getNbColonnes();
+    if (nbLignes == 0 || nbColonnes == 0) return;
+    const uint8_t* octets = reinterpret_cast<const uint8_t*>(pixels.data());
+
+    if (!initialise || affichee.getNbLignes() != nbLignes || affichee.getNbColonnes() != nbColonnes) {
+        // Première image ou nouvelles dimensions : texture complète
+        if (!texture.create(nbColonnes, nbLignes)) {
+            cerr << "Erreur : Impossible de creer une texture de " << nbColonnes << "x" << nbLignes << endl;
+            return;
+        }
+        pixels.assign((size_t)nbLignes * nbColonnes, PIXEL_MORT);
+        octets = reinterpret_cast<const uint8_t*>(pixels.data());
+        for (int x = 0; x < nbLignes; ++x) convertirLigne(etat, x);
+        texture.update(octets);
+        sprite.setTexture(texture, true);
+        sprite.setScale((float)pixelSize, (float)pixelSize);
+        affichee = etat;
+        initialise = true;
+    } else {
+        // Lignes modifiées, regroupées en suites consécutives envoyées chacune en un appel
+        const size_t taille = (size_t)etat.getMotsParLigne() * sizeof(uint64_t);
+        vector<pair<int, int>> suites; // [debut, fin)
+        for (int x = 0; x < nbLignes; ++x) {
+            if (memcmp(etat.ligne(x), affichee.ligne(x), taille) == 0) continue;
+            convertirLigne(etat, x);
+            memcpy(affichee.ligne(x), etat.ligne(x), taille);
+            if (!suites.empty() && suites.back().second == x) suites.back().second = x + 1;
+            else suites.push_back({x, x + 1});
+        }
+        if ((int)suites.size() > MAX_ENVOIS_PAR_IMAGE) {
+            suites = {{suites.front().first, suites.back().second}};
+        }
+        for (const pair<int, int>& suite : suites) {
+            texture.update(octets + (size_t)suite.first * nbColonnes * sizeof(uint32_t),
+                           nbColonnes, suite.second - suite.first, 0, suite.first);
+        }
+        sprite.setScale((float)pixelSize, (float)pixelSize);
+    }
+
+    window.draw(sprite); // Un seul appel de dessin, quel que soit le nombre de cellules
+}
@@ -0,0 +1,27 @@
+#ifndef RENDUGRILLE_H
+#define RENDUGRILLE_H
+
+#include <vector>
+#include <cstdint>
+#include <SFML/Graphics.hpp>
+#include "GrilleBits.h"
+
+// Affichage de la grille en un seul appel de dessin : un texel par cellule dans une texture,
+// agrandie à la taille des cellules par un sprite. Seules les lignes modifiées depuis l'image
+// précédente sont recopiées dans la texture.
+class RenduGrille {
+private:
+    sf::Texture texture;
+    sf::Sprite sprite;
+    std::vector<uint32_t> pixels; // Une couleur RGBA par cellule, ligne après ligne
+    GrilleBits affichee;          // Génération actuellement dans la texture
+    bool initialise;
+
+    void convertirLigne(const GrilleBits& etat, int x); // Cellules de la ligne x -> pixels
+
+public:
+    RenduGrille();
+    void dessiner(sf::RenderWindow& window, const GrilleBits& etat, int pixelSize);
+};
+
+#endif // RENDUGRILLE_H
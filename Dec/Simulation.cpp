@@ -3,15 +3,233 @@
 #include <filesystem>
 #include <chrono>
 #include <string>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include "LecteurArchive.h"
+#include "Instrumentation.h"
+#include "PointReprise.h"
+#include "Chargeur.h"
 using namespace std;
 namespace fs = std::filesystem;
 
 
 // Constructeur
-Simulation::Simulation(const std::string& filename, int iterations, int pixelSize)
-    : grille(0, 0), iterations(iterations), pixelSize(pixelSize) {
-    folderPath = createSimulationFolder(filename);
-    grille.ficher(filename);
+Simulation::Simulation(const Parametres& parametres, const PointReprise* reprise)
+    : grille(0, 0, parametres.moteur, parametres.nbThreads), iterations(parametres.iterations), pixelSize(parametres.pixelSize),
+      saut(parametres.saut), intervalleSauvegarde(parametres.intervalleSauvegarde), sansFenetre(parametres.sansFenetre),
+      premiereIteration(1), intervalleReprise(parametres.intervalleReprise), dureeReprise(chrono::seconds(parametres.secondesReprise)),
+      derniereReprise(chrono::steady_clock::now()), pasAvance(parametres.pasAvance),
+      sauvegardeGrilles(parametres.format != FormatSortie::Statistiques),
+      parPassages(parametres.profondeur > 1 && !parametres.detectionCycles && !parametres.statistiques),
+      course(extraireCourse(parametres)), mode(ModeCalcul::Pause), objectif(0),
+      generationsParImage(parametres.generationsParImage), credit(0), arretCalcul(false), termine(false), periodeFinale(0),
+      generationCalculee(0), imageDemandee(false), generationImage(0), imageNeuve(false) {
+    if (parametres.dossierSortie.empty()) {
+        folderPath = createSimulationFolder(parametres.fichier.empty() ? "aleatoire" : parametres.fichier);
+    } else {
+        folderPath = parametres.dossierSortie;
+        fs::create_directories(folderPath); // Dossier imposé : créé s'il n'existe pas
+    }
+    bool avecReprise = parametres.reprendre || intervalleReprise > 0 || parametres.secondesReprise > 0;
+    if (avecReprise && parametres.moteur == TypeMoteur::Plan) {
+        cerr << "Erreur : points de reprise indisponibles avec le moteur plan (seule la fenetre est exportee)" << endl;
+        exit(1);
+    }
+    grille.setRegle(parametres.regle);
+    grille.setSuiviStatistiques(parametres.statistiques);
+    grille.setProfondeur(parametres.profondeur);
+    if (parametres.reprendre) {
+        const PointReprise& point = *reprise; // Paramètres de course déjà repris par reprendreCourse
+        grille.setRegle(point.regle);
+        if (!grille.reprendre(point.etat, point.historique)) {
+            cerr << "Erreur : historique du point de reprise invalide" << endl;
+            exit(1);
+        }
+        saut = 0;
+        premiereIteration = (int)point.generation + 1;
+        cout << "Reprise a la generation " << point.generation << endl;
+    } else if (parametres.aleatoireLignes > 0) {
+        grille.aleatoire(parametres.aleatoireLignes, parametres.aleatoireColonnes, parametres.densite, parametres.graine);
+    } else {
+        string regleMotif;
+        grille.ficher(parametres.fichier, parametres.lignesMin, parametres.colonnesMin, &regleMotif);
+        grille.setRegle(Chargeur::choisirRegle(regleMotif, parametres.regle, parametres.regleImposee));
+    }
+    grille.setDetectionCycles(parametres.detectionCycles);
+    if (parametres.statistiques) {
+        string chemin = folderPath + "/statistiques.jdvs";
+        if (parametres.reprendre) flux.reprendre(chemin, reprise->generation); // Les générations suivantes sont recalculées
+        else {
+            flux.ouvrir(chemin);
+            if (saut == 0) enregistrerStatistiques(0);
+        }
+    }
+    if (!parametres.fichierMesures.empty()) {
+#ifdef JDV_INSTRUMENTATION
+        if (!Instrumentation::ouvrir(parametres.fichierMesures, parametres.mesuresJson, parametres.intervalleMesures,
+                                     parametres.compteursMateriel)) {
+            cerr << "Erreur : Impossible de creer " << parametres.fichierMesures << endl;
+            exit(1);
+        }
+#else
+        cerr << "Attention : programme compile sans l'option INSTRUMENTATION, --mesures est ignore" << endl;
+#endif
+    }
+    ecrivain.demarrer(parametres.format, folderPath, grille.getNbLignes(), grille.getNbColonnes(), parametres.intervalleCles,
+                      parametres.capaciteFile, parametres.politique, parametres.reprendre ? &reprise->archive : nullptr);
+    if (parametres.format == FormatSortie::Archive && saut == 0 && !parametres.reprendre) ecrivain.soumettre(0, grille.getEtat()); // Configuration initiale
+}
+
+bool Simulation::doitSauvegarder(int iteration) const {
+    return sauvegardeGrilles && intervalleSauvegarde > 0 && iteration % intervalleSauvegarde == 0;
+}
+
+void Simulation::sauvegarder(int iteration) {
+    MESURER_PHASE(Phase::Sauvegarde);
+    ecrivain.soumettre(iteration, grille.getEtat());
+}
+
+bool Simulation::doitEcrireReprise(int iteration) const {
+    if (intervalleReprise > 0 && iteration % intervalleReprise == 0) return true;
+    return dureeReprise.count() > 0 && chrono::steady_clock::now() - derniereReprise >= dureeReprise;
+}
+
+int Simulation::prochainArret(int iteration) const {
+    int arret = iterations;
+    if (sauvegardeGrilles && intervalleSauvegarde > 0) {
+        arret = min(arret, (iteration + intervalleSauvegarde - 1) / intervalleSauvegarde * intervalleSauvegarde);
+    }
+    if (intervalleReprise > 0) arret = min(arret, (iteration + intervalleReprise - 1) / intervalleReprise * intervalleReprise);
+    if (dureeReprise.count() > 0) arret = min(arret, iteration + 1023); // L'horloge n'est consultée qu'aux arrêts
+    return max(arret, iteration);
+}
+
+// Seules les copies se font ici : l'encodage et l'écriture du fichier ont lieu sur le thread d'écriture
+void Simulation::ecrireReprise(int iteration) {
+    MESURER_PHASE(Phase::Sauvegarde);
+    flux.vider(); // Le flux contient au moins les générations du point de reprise
+    auto point = make_unique<PointReprise>();
+    point->generation = iteration;
+    point->regle = grille.getMoteur().getRegle();
+    point->course = course;
+    point->etat = grille.getEtat();
+    grille.capturerHistorique(point->historique);
+    ecrivain.soumettreReprise(std::move(point));
+    derniereReprise = chrono::steady_clock::now();
+}
+
+// L'état stabilisé n'est jamais abandonné : la file est vidée avant de continuer
+void Simulation::sauvegarderStabilisation(int iteration) {
+    if (!sauvegardeGrilles) return;
+    ecrivain.soumettre(iteration, grille.getEtat(), EcrivainAsynchrone::Type::Stabilisation);
+    ecrivain.vider();
+}
+
+void Simulation::enregistrerStatistiques(long long iteration) {
+    if (!flux.estOuvert()) return;
+    MESURER_PHASE(Phase::Sauvegarde);
+    StatistiquesGeneration stats;
+    grille.statistiques(stats);
+    flux.ajouter(iteration, stats);
+}
+
+bool Simulation::peutAvancer() const {
+    if (termine) return false;
+    if (mode == ModeCalcul::Objectif) return generationCalculee < objectif;
+    return mode == ModeCalcul::Continu && (generationsParImage == 0 || credit > 0);
+}
+
+// Thread de calcul : avance à la vitesse du moteur tant que le mode le permet, sauvegarde comme le mode
+// sans fenêtre, et ne copie la grille que lorsque la fenêtre demande une image ou quand le calcul s'arrête
+void Simulation::boucleCalcul(int currentIteration) {
+    unique_lock<mutex> verrouillage(verrouCalcul);
+    while (true) {
+        reveilCalcul.wait(verrouillage, [this] { return arretCalcul || peutAvancer(); });
+        if (arretCalcul) break;
+        if (mode == ModeCalcul::Continu && generationsParImage > 0) --credit;
+        verrouillage.unlock();
+
+        bool evolue = grille.updateGrille();
+        enregistrerStatistiques(currentIteration);
+        if (!evolue) {
+            cout << "Simulation stabilisée à l'itération " << currentIteration << " (période " << grille.getPeriode() << ")" << endl;
+            sauvegarderStabilisation(currentIteration);
+        } else {
+            if (doitSauvegarder(currentIteration)) sauvegarder(currentIteration);
+            if (doitEcrireReprise(currentIteration)) ecrireReprise(currentIteration);
+            INSTRUMENTER_GENERATION(currentIteration, grille.getMoteur());
+        }
+        generationCalculee = currentIteration;
+
+        verrouillage.lock();
+        if (!evolue) periodeFinale = grille.getPeriode();
+        if (!evolue || currentIteration >= iterations) termine = true;
+        if (mode == ModeCalcul::Objectif && currentIteration >= objectif) mode = ModeCalcul::Pause; // Objectif atteint
+        bool inactif = !peutAvancer();
+        verrouillage.unlock();
+        if (imageDemandee.exchange(false) || inactif) publierImage(currentIteration);
+        verrouillage.lock();
+        currentIteration++;
+    }
+}
+
+void Simulation::publierImage(long long generation) {
+    const GrilleBits& etat = grille.getEtat(); // Exportée par le thread de calcul, seul à toucher au moteur
+    lock_guard<mutex> verrouillage(verrouImage);
+    image = etat;
+    generationImage = generation;
+    imageNeuve = true;
+}
+
+#ifdef JDV_FENETRE
+// Espace : marche/pause ; N : pasAvance générations ; S : jusqu'à la stabilisation ;
+// haut/+ et bas/- : double ou divise par deux les générations par image (au-delà de 65536 : sans limite)
+void Simulation::commande(sf::Keyboard::Key touche) {
+    const int MAX_PAR_IMAGE = 1 << 16;
+    {
+        lock_guard<mutex> verrouillage(verrouCalcul);
+        if (touche == sf::Keyboard::Space) mode = mode == ModeCalcul::Pause ? ModeCalcul::Continu : ModeCalcul::Pause;
+        else if (touche == sf::Keyboard::N) {
+            mode = ModeCalcul::Objectif;
+            objectif = generationCalculee + pasAvance;
+        }
+        else if (touche == sf::Keyboard::S) {
+            mode = ModeCalcul::Objectif;
+            objectif = iterations;
+        }
+        else if (touche == sf::Keyboard::Up || touche == sf::Keyboard::Add || touche == sf::Keyboard::Equal) {
+            if (generationsParImage > 0) generationsParImage = generationsParImage >= MAX_PAR_IMAGE ? 0 : generationsParImage * 2;
+        }
+        else if (touche == sf::Keyboard::Down || touche == sf::Keyboard::Subtract || touche == sf::Keyboard::Hyphen) {
+            generationsParImage = generationsParImage == 0 ? MAX_PAR_IMAGE : max(1, generationsParImage / 2);
+        }
+        else return;
+    }
+    reveilCalcul.notify_one();
+}
+#endif
+
+// Outil d'export : réécrit les générations demandées d'une archive au format texte historique
+void Simulation::exporterArchive(const Parametres& parametres) {
+    string dossier = parametres.dossierSortie.empty() ? "." : parametres.dossierSortie;
+    fs::create_directories(dossier);
+    if (fs::path(parametres.archiveExport).extension() == ".jdvs") { // Flux de statistiques : une ligne CSV par génération
+        FluxStatistiques::exporterCsv(parametres.archiveExport, dossier + "/statistiques.csv");
+        return;
+    }
+    LecteurArchive lecteur(parametres.archiveExport);
+
+    GrilleBits etat;
+    int exportees = 0;
+    for (const EntreeIndex& entree : lecteur.getIndex()) {
+        if (entree.generation < parametres.exportDebut) continue;
+        if (parametres.exportFin >= 0 && entree.generation > parametres.exportFin) break;
+        lecteur.lire(entree.generation, etat);
+        Grille::ecrireIteration(etat, entree.generation, dossier);
+        exportees++;
+    }
+    cout << exportees << " generation(s) exportee(s) dans " << dossier << endl;
 }
 std::string getBaseName(const string& filepath) {
          size_t lastSlash = filepath.find_last_of("/\\"); // Trouve le dernier '/' ou '\' dans le chemin
@@ -42,6 +260,15 @@ std::string Simulation::createSimulationFolder(const std::string& filename) {
 
 // Méthode pour exécuter la simulation
 void Simulation::run() {
+#ifndef JDV_FENETRE
+        if (!sansFenetre) cerr << "Attention : programme compile sans SFML, calcul sans fenetre" << endl;
+        runHeadless();
+#else
+        if (sansFenetre) {
+            runHeadless();
+            return;
+        }
+
         // Crée une fenêtre graphique avec des dimensions adaptées à la grille
         sf::RenderWindow window(sf::VideoMode(grille.getNbColonnes() * pixelSize + 50, grille.getNbLignes() * pixelSize + 50), "Jeu de la Vie");
 
@@ -59,36 +286,138 @@ void Simulation::run() {
         text.setFillColor(sf::Color::White); // Définit la couleur du texte (blanc)
         text.setPosition(10, grille.getNbLignes() * pixelSize); // Positionne le texte sous la grille
 
-        int currentIteration = 1; // Initialise le compteur d'itérations
-        bool spacePressed = false; // Indique si la barre espace est appuyée
-        auto lastUpdate = chrono::steady_clock::now(); // Enregistre l'instant de la dernière mise à jour
-         const int SPACE_PRESS_DELAY = 150;
+        window.setFramerateLimit(60); // Une image par rafraîchissement, quel que soit le rythme du moteur
 
-        // Boucle principale de la simulation
-        while (window.isOpen() && currentIteration <= iterations) {
+        int currentIteration = premiereIteration; // Initialise le compteur d'itérations
+
+        // Saute directement à la génération demandée puis l'enregistre
+        if (saut > 0) {
+            grille.avancer(saut);
+            if (doitSauvegarder((int)saut)) sauvegarder((int)saut);
+            enregistrerStatistiques(saut);
+            currentIteration = (int)saut + 1;
+        }
+        GrilleBits affichee = grille.getEtat(); // Copie dessinée, échangée avec la dernière image publiée
+        long long generationAffichee = currentIteration - 1;
+        generationCalculee = generationAffichee;
+        calcul = thread(&Simulation::boucleCalcul, this, currentIteration);
+
+        auto debutMesure = chrono::steady_clock::now();
+        long long generationMesure = generationAffichee;
+        double vitesse = 0; // Générations/s mesurées sur la dernière demi-seconde
+
+        // Boucle de la fenêtre : événements, commandes du thread de calcul, affichage de la dernière image
+        while (window.isOpen()) {
             sf::Event event; // Gère les événements utilisateur
             while (window.pollEvent(event)) {
                 if (event.type == sf::Event::Closed) window.close(); // Ferme la fenêtre si l'utilisateur clique sur la croix
-                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Space) spacePressed = true; // Barre espace appuyée
-                if (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::Space) spacePressed = false; // Barre espace relâchée
+                if (event.type == sf::Event::KeyPressed) {
+                    if (event.key.code == sf::Keyboard::Escape) window.close();
+                    else commande(event.key.code);
+                }
             }
 
-            auto now = chrono::steady_clock::now(); // Enregistre l'instant actuel
-
-            // Si la barre espace est maintenue et que le délai est respecté
-            if (spacePressed && chrono::duration_cast<chrono::milliseconds>(now - lastUpdate).count() >= SPACE_PRESS_DELAY) {
-                if (!grille.updateGrille()) { // Met à jour la grille et vérifie si elle est stabilisée
-                    cout << "Simulation stabilisée à l'itération " << currentIteration << endl;
-                    grille.saveStabilisation(currentIteration, folderPath); // Sauvegarde l'état stabilisé
-                    break; // Termine la simulation si stabilisée
+            string etatCalcul;
+            {
+                lock_guard<mutex> verrouillage(verrouCalcul);
+                credit = generationsParImage; // Au plus generationsParImage générations jusqu'à l'image suivante
+                if (termine) etatCalcul = periodeFinale > 0 ? "stabilisee (periode " + to_string(periodeFinale) + ")" : "terminee";
+                else if (mode == ModeCalcul::Pause) etatCalcul = "pause";
+                else etatCalcul = mode == ModeCalcul::Objectif ? "jusqu'a " + to_string(objectif) : "en cours";
+                etatCalcul += " | " + (generationsParImage > 0 ? to_string(generationsParImage) : string("max")) + " gen/image";
+            }
+            reveilCalcul.notify_one();
+            imageDemandee = true;
+            {
+                lock_guard<mutex> verrouillage(verrouImage);
+                if (imageNeuve) {
+                    swap(image, affichee);
+                    generationAffichee = generationImage;
+                    imageNeuve = false;
                 }
-                grille.saveIteration(currentIteration, folderPath); // Sauvegarde l'état actuel
-                grille.afficherGraphique(window, text, pixelSize, currentIteration); // Met à jour l'affichage
-                currentIteration++; // Passe à l'itération suivante
-                lastUpdate = now; // Met à jour l'instant de la dernière mise à jour
             }
+
+            auto maintenant = chrono::steady_clock::now();
+            double ecoule = chrono::duration<double>(maintenant - debutMesure).count();
+            if (ecoule >= 0.5) {
+                long long calculee = generationCalculee;
+                vitesse = (calculee - generationMesure) / ecoule;
+                generationMesure = calculee;
+                debutMesure = maintenant;
+            }
+
+            MESURER_PHASE(Phase::Affichage);
+            ostringstream legende;
+            legende << "Iteration : " << generationAffichee << " | " << fixed << setprecision(0) << vitesse << " gen/s | " << etatCalcul;
+            grille.afficherGraphique(window, text, pixelSize, affichee, legende.str());
         }
 
+        {
+            lock_guard<mutex> verrouillage(verrouCalcul);
+            arretCalcul = true;
+        }
+        reveilCalcul.notify_one();
+        calcul.join(); // La génération en cours se termine avant l'arrêt
+        ecrivain.arreter(); // Attend les dernières écritures et ferme l'archive
+        flux.fermer();
+#ifdef JDV_INSTRUMENTATION
+        Instrumentation::fermer();
+#endif
         cout << "Simulation terminée !" << endl; // Affiche un message de fin
+#endif
 }
 
+
+// Méthode pour exécuter la simulation sans affichage
+void Simulation::runHeadless() {
+        auto debut = chrono::steady_clock::now();
+        long long generations = 0; // Générations réellement calculées
+        int currentIteration = premiereIteration;
+
+        if (saut > 0) {
+            grille.avancer(saut);
+            generations += saut;
+            if (doitSauvegarder((int)saut)) sauvegarder((int)saut);
+            enregistrerStatistiques(saut);
+            currentIteration = (int)saut + 1;
+        }
+
+        while (currentIteration <= iterations) {
+            // Sans détection ni statistiques, les générations intermédiaires ne sont pas observées : le moteur
+            // les enchaîne d'un seul appel (par passages de plusieurs générations en cache avec --profondeur)
+            int pas = parPassages ? prochainArret(currentIteration) - currentIteration + 1 : 1;
+            bool evolue = true;
+            if (pas > 1) {
+                grille.avancer(pas);
+                currentIteration += pas - 1;
+            } else {
+                evolue = grille.updateGrille();
+            }
+            generations += pas;
+            enregistrerStatistiques(currentIteration);
+            if (!evolue) {
+                cout << "Simulation stabilisée à l'itération " << currentIteration << " (période " << grille.getPeriode() << ")" << endl;
+                sauvegarderStabilisation(currentIteration);
+                break;
+            }
+            if (doitSauvegarder(currentIteration)) sauvegarder(currentIteration);
+            if (doitEcrireReprise(currentIteration)) ecrireReprise(currentIteration);
+            INSTRUMENTER_GENERATION(currentIteration, grille.getMoteur());
+            currentIteration++;
+        }
+
+        ecrivain.arreter(); // Attend les dernières écritures et ferme l'archive
+        flux.fermer();
+#ifdef JDV_INSTRUMENTATION
+        Instrumentation::fermer();
+#endif
+        double secondes = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+        cout << "Simulation terminée !" << endl;
+        cout << "Générations calculées : " << generations << endl;
+        cout << "Durée totale : " << fixed << setprecision(3) << secondes << " s" << endl;
+        cout << "Vitesse : " << setprecision(1) << (secondes > 0 ? generations / secondes : 0.0) << " générations/s" << endl;
+        if (grille.getTuilesCalculees() >= 0 && generations > 0) {
+            cout << "Tuiles recalculées par génération : " << (double)grille.getTuilesCalculees() / generations << endl;
+        }
+        if (ecrivain.getAbandonnees() > 0) cout << "Itérations non sauvegardées (file pleine) : " << ecrivain.getAbandonnees() << endl;
+}
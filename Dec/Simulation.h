@@ -1,20 +1,81 @@
 #ifndef SIMULATION_H
 #define SIMULATION_H
 
+#ifdef JDV_FENETRE
 #include <SFML/Graphics.hpp>
+#endif
 #include "Grille.h"
+#include "Parametres.h"
+#include "EcrivainAsynchrone.h"
+#include "FluxStatistiques.h"
 #include <string>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+struct PointReprise;
+
 class Simulation {
 private:
+    // Visionneuse : le moteur tourne sur un thread de calcul, la fenêtre affiche la dernière génération terminée
+    enum class ModeCalcul { Pause, Continu, Objectif };
+
     Grille grille;
     std::string folderPath;
     int iterations;
     int pixelSize;
+    long long saut; // Génération atteinte directement avant l'affichage (0 = aucune)
+    int intervalleSauvegarde; // Une itération sur N est sauvegardée (0 = aucune)
+    bool sansFenetre;
+    EcrivainAsynchrone ecrivain; // Sauvegardes écrites sur un thread dédié (archive ou fichiers texte)
+    int premiereIteration; // 1, ou la génération qui suit le point de reprise
+    int intervalleReprise; // Un point de reprise toutes les N générations (0 = aucun)
+    std::chrono::steady_clock::duration dureeReprise; // Un point de reprise après cette durée (0 = aucun)
+    std::chrono::steady_clock::time_point derniereReprise;
+    int pasAvance;         // Générations calculées par la touche N
+    FluxStatistiques flux; // statistiques.jdvs, alimenté par le thread de calcul (fermé si --statistiques est absent)
+    bool sauvegardeGrilles; // Faux pour le format statistiques : aucune grille écrite
+    bool parPassages;       // Sans fenêtre : avance par grille.avancer jusqu'à la prochaine sauvegarde (blocage temporel)
+    ParametresCourse course; // Recopiés dans chaque point de reprise
+
+    std::thread calcul;
+    std::mutex verrouCalcul;            // Protège les commandes ci-dessous
+    std::condition_variable reveilCalcul;
+    ModeCalcul mode;
+    long long objectif;                 // Mode Objectif : dernière génération à calculer
+    int generationsParImage;            // Mode Continu : générations au plus par image affichée (0 = sans limite)
+    int credit;                         // Générations encore permises avant la prochaine image
+    bool arretCalcul, termine;
+    int periodeFinale;                  // Période de la stabilisation (0 = limite d'itérations atteinte)
+    std::atomic<long long> generationCalculee;
+    std::atomic<bool> imageDemandee;    // La fenêtre attend une nouvelle image
+    std::mutex verrouImage;
+    GrilleBits image;                   // Dernière génération publiée, échangée avec la copie affichée
+    long long generationImage;
+    bool imageNeuve;
+
+    bool doitSauvegarder(int iteration) const;
+    void sauvegarder(int iteration); // Dépose l'itération dans la file d'écriture
+    void sauvegarderStabilisation(int iteration); // Dépose l'état stabilisé et attend qu'il soit écrit
+    void enregistrerStatistiques(long long iteration);
+    bool doitEcrireReprise(int iteration) const;
+    int prochainArret(int iteration) const; // Première itération >= iteration à sauvegarder, à reprendre ou la dernière
+    void ecrireReprise(int iteration); // Copie la grille et l'historique puis les confie au thread d'écriture
+    bool peutAvancer() const;          // Appelée sous verrouCalcul
+    void boucleCalcul(int premiere);   // Thread de calcul de la visionneuse
+    void publierImage(long long generation);
+#ifdef JDV_FENETRE
+    void commande(sf::Keyboard::Key touche);
+#endif
 
 public:
-    Simulation(const std::string& filename, int iterations, int pixelSize);
+    Simulation(const Parametres& parametres, const PointReprise* reprise = nullptr); // reprise : point lu pour --reprendre
     std::string createSimulationFolder(const std::string& filename);
     void run();
+    void runHeadless(); // Calcul sans fenêtre ni clavier, au maximum de la vitesse du moteur
+    static void exporterArchive(const Parametres& parametres); // Archive -> un fichier texte par génération (.jdvs -> CSV)
 };
 
 #endif // SIMULATION_H
@@ -0,0 +1,35 @@
+#!/bin/sh
+# Rapport de passage à l'échelle du moteur parallèle.
+# Lance la même simulation sans fenêtre pour chaque nombre de threads et écrit un fichier CSV :
+# threads, durée, générations/s, accélération et efficacité par rapport à un thread.
+#
+# Usage : ./echelle.sh [executable] [LxC] [iterations] [threads...]
+# Exemple : ./echelle.sh ./jeu_de_la_vie 10000x10000 100 1 2 4 8 16 32
+
+EXECUTABLE=${1:-./jeu_de_la_vie}
+TAILLE=${2:-10000x10000}
+ITERATIONS=${3:-100}
+[ $# -gt 3 ] && shift 3 || set -- 1 2 4 8 16 32
+RAPPORT=${RAPPORT:-echelle.csv}
+SORTIE=$(mktemp -d)
+
+# Le moteur fixe lui-même ses travailleurs sur des coeurs distincts et place chaque bande sur leur nœud NUMA
+
+echo "threads,secondes,generations_par_seconde,acceleration,efficacite" > "$RAPPORT"
+REFERENCE=""
+for T in "$@"; do
+    SECONDES=$("$EXECUTABLE" --sans-fenetre --sans-cycle --moteur parallele --threads "$T" \
+        --aleatoire "$TAILLE" --graine 1 --iterations "$ITERATIONS" --intervalle 0 --sortie "$SORTIE" \
+        | sed -n 's/^Durée totale : \([0-9.]*\) s$/\1/p')
+    if [ -z "$SECONDES" ]; then
+        echo "Erreur : execution impossible avec $T threads" >&2
+        rm -rf "$SORTIE"
+        exit 1
+    fi
+    [ -z "$REFERENCE" ] && REFERENCE=$SECONDES
+    awk -v t="$T" -v s="$SECONDES" -v r="$REFERENCE" -v n="$ITERATIONS" \
+        'BEGIN { a = r / s; printf "%d,%.3f,%.2f,%.2f,%.2f\n", t, s, n / s, a, a / t }' | tee -a "$RAPPORT"
+done
+
+rm -rf "$SORTIE"
+echo "Rapport écrit dans $RAPPORT"
@@ -1,21 +1,37 @@
 #include "Simulation.h"
+#include "Parametres.h"
+#include "PointReprise.h"
 #include <iostream>
 #include <string>
 using namespace std ;
-int main() {
-    string filename; // NOM du fichier d'entrée
-    int iterations; // Nombre d'itérations souhaitées
-    int pixelSize; // Taille des pixels pour l'affichage graphique
+int main(int argc, char* argv[]) {
+    Parametres parametres; // Fichier, itérations, moteur, sorties...
 
-    // Demande les paramètres à l'utilisateur
-    cout << "Entrez le NOM du fichier d'entree : ";
-    cin >> filename;
-    cout << "Entrez le nombre d'iterations : ";
-    cin >> iterations;
-    cout << "Entrez la taille des pixels (ex : 20) : ";
-    cin >> pixelSize;
+    if (argc > 1) {
+        // Paramètres passés sur la ligne de commande (utilisable sans clavier ni écran)
+        if (!lireArguments(argc, argv, parametres)) {
+            afficherUsage(argv[0]);
+            return 1;
+        }
+    } else {
+        demanderParametres(parametres); // Demande les paramètres à l'utilisateur
+    }
 
-    Simulation simulation(filename, iterations, pixelSize); // Crée une instance de Simulation
+    if (!parametres.archiveExport.empty()) {
+        Simulation::exporterArchive(parametres); // Outil d'export : aucune simulation
+        return 0;
+    }
+
+    PointReprise point; // --reprendre : état et paramètres de course de la simulation interrompue
+    if (parametres.reprendre) {
+        if (!PointReprise::chercher(parametres.dossierSortie, point)) {
+            cerr << "Erreur : aucun point de reprise valide dans " << parametres.dossierSortie << endl;
+            return 1;
+        }
+        if (!reprendreCourse(parametres, point.course)) return 1;
+    }
+
+    Simulation simulation(parametres, parametres.reprendre ? &point : nullptr); // Crée une instance de Simulation
     simulation.run(); // Lance la simulation
 
     return 0; // Retourne 0 pour indiquer que le programme s'est terminé correctement
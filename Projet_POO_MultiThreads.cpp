@@ -1,12 +1,17 @@
 #include <SFML/Graphics.hpp> // Bibliothèque utilisée pour l'affichage graphique
 #include <iostream>          // Pour l'entrée et la sortie standard
 #include <vector>            // Pour gérer la grille en tant que matrice 2D
-#include <set>               // Pour stocker les configurations uniques de la grille
+#include <unordered_set>     // Pour stocker les empreintes des configurations déjà vues
+#include <deque>             // Pour oublier les empreintes les plus anciennes
 #include <fstream>           // Pour lire et écrire des fichiers
 #include <filesystem>        // Pour la gestion des fichiers et des dossiers
 #include <sstream>           // Pour manipuler des chaînes de caractères
 #include <chrono>            // Pour gérer le temps et les délais
 #include <omp.h>	     // Pour gerer le paraléllisme sur plusieur coeur facilement
+#include <cstdint>           // Pour les cellules stockées sur un octet
+#include <algorithm>         // Pour copier les lignes du halo
+#include <cstring>           // Pour comparer les cellules 8 par 8
+#include "Empreinte.h"       // Empreinte de Zobrist des configurations (Dec/)
 
 
 using namespace std;
@@ -82,40 +87,47 @@ public:
 class Grille : public RegleSt {
 private:
     int dim1, dim2;                   // Dimensions de la grille (lignes, colonnes)
-    vector<vector<bool>> grille;      // Matrice contenant l'état des cellules (true = vivante, false = morte)
-    set<Position> cellulesVivantes;  // Ensemble des cellules actuellement vivantes
-    set<string> configurations;      // Historique des configurations uniques pour détecter les répétitions
-
-    // **Méthode pour notifier les voisins d'une cellule vivante**
-    void notifierVoisines(const Position& pos, map<Position, int>& voisins) {
-        for (int dx = -1; dx <= 1; ++dx) {       // Parcourt les 8 voisins potentiels (y compris diagonales)
-            for (int dy = -1; dy <= 1; ++dy) {
-                if (dx == 0 && dy == 0) continue; // Ignore la cellule elle-même
-
-                // Calcul des coordonnées voisines avec gestion de la grille torique
-                int nx = (pos.getX() + dx + dim1) % dim1; // Gestion des bords pour la coordonnée x
-                int ny = (pos.getY() + dy + dim2) % dim2; // Gestion des bords pour la coordonnée y
-
-                voisins[Position(nx, ny)]++; // Incrémente le nombre de voisins pour cette position
-            }
+    int largeur;                      // Largeur d'une ligne avec ses deux colonnes de halo (dim2 + 2)
+    vector<uint8_t> cellules;         // Grille contiguë (dim1 + 2) x (dim2 + 2) : 1 = vivante, 0 = morte, bordée d'un halo
+    vector<uint8_t> suivantes;        // Second tampon : la génération suivante y est écrite puis les tampons sont échangés
+    long long population;             // Nombre de cellules vivantes
+    Empreinte empreinte;              // Empreinte de la configuration courante
+    unordered_set<Empreinte, HachageEmpreinte> configurations; // Empreintes des dernières configurations, pour détecter les répétitions
+    deque<Empreinte> ordre;           // Les mêmes empreintes dans l'ordre des générations (fenêtre bornée)
+    static const size_t CAPACITE_HISTORIQUE = 1 << 20; // 16 octets par configuration retenue
+
+    // **Accès à une cellule (coordonnées sans le halo)**
+    uint8_t& cellule(int i, int j) { return cellules[(size_t)(i + 1) * largeur + (j + 1)]; }
+    bool estVivante(int i, int j) const { return cellules[(size_t)(i + 1) * largeur + (j + 1)] != 0; }
+
+    // **Recopie les bords opposés dans le halo pour gérer la grille torique sans modulo**
+    void remplirHalo() {
+        uint8_t* c = cellules.data();
+        copy(c + (size_t)dim1 * largeur, c + (size_t)(dim1 + 1) * largeur, c);           // Ligne du haut <- dernière ligne
+        copy(c + (size_t)largeur, c + (size_t)2 * largeur, c + (size_t)(dim1 + 1) * largeur); // Ligne du bas <- première ligne
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < dim1 + 2; ++i) {
+            uint8_t* ligne = c + (size_t)i * largeur;
+            ligne[0] = ligne[dim2];          // Colonne de gauche <- dernière colonne
+            ligne[dim2 + 1] = ligne[1];      // Colonne de droite <- première colonne
         }
     }
 
-    // **Génère une chaîne représentant l'état actuel de la grille**
-    // Cela permet de comparer facilement deux configurations
-    string getConfigurationString() const {
-        stringstream ss;
-        for (const auto& row : grille) {
-            for (bool cell : row) {
-                ss << (cell ? "1" : "0"); // Ajoute '1' si la cellule est vivante, '0' sinon
-            }
+    // **Retient l'empreinte courante ; faux si elle a déjà été vue (configuration répétée)**
+    bool memoriser() {
+        if (!configurations.insert(empreinte).second) return false;
+        ordre.push_back(empreinte);
+        if (ordre.size() > CAPACITE_HISTORIQUE) { // La plus ancienne est oubliée : mémoire bornée
+            configurations.erase(ordre.front());
+            ordre.pop_front();
         }
-        return ss.str(); // Retourne la chaîne correspondant à l'état actuel
+        return true;
     }
 
 public:
     // **Constructeur**
-    Grille(int dim1, int dim2) : dim1(dim1), dim2(dim2), grille(dim1, vector<bool>(dim2, false)) {}
+    Grille(int dim1, int dim2) : dim1(dim1), dim2(dim2), largeur(dim2 + 2),
+        cellules((size_t)(dim1 + 2) * (dim2 + 2), 0), suivantes((size_t)(dim1 + 2) * (dim2 + 2), 0), population(0) {}
 
     // **Charge une grille initiale depuis un fichier**
     void ficher(const string& filename) {
@@ -126,74 +138,87 @@ public:
         }
 
         file >> dim1 >> dim2; // Lit les dimensions de la grille depuis le fichier
-        grille.resize(dim1, vector<bool>(dim2, false)); // Redimensionne la grille
+        largeur = dim2 + 2;
+        cellules.assign((size_t)(dim1 + 2) * largeur, 0); // Redimensionne la grille et son halo
+        suivantes.assign(cellules.size(), 0);
+        population = 0;
+        empreinte = Empreinte();
+        configurations.clear();
+        ordre.clear();
 
         for (int i = 0; i < dim1; ++i) {
             for (int j = 0; j < dim2; ++j) {
                 int state;
                 file >> state; // Lit l'état de chaque cellule (0 ou 1)
-                grille[i][j] = (state == 1); // Affecte l'état à la cellule
-                if (grille[i][j]) cellulesVivantes.insert(Position(i, j)); // Ajoute la cellule à l'ensemble si elle est vivante
+                cellule(i, j) = (state == 1); // Affecte l'état à la cellule
+                population += (state == 1);
+                if (state == 1) empreinte.basculer(cleCellule(i, j));
             }
         }
 
         file.close(); // Ferme le fichier après lecture
-        configurations.insert(getConfigurationString()); // Ajoute la configuration initiale à l'historique
+        memoriser(); // Ajoute la configuration initiale à l'historique
     }
 
 // __________ Intégration du parallelisme dans cette méthode __________
 
     bool updateGrille() {
-    map<Position, int> voisins; // Compte les voisins de chaque cellule
-
-    // Parcourt les cellules vivantes pour notifier leurs voisines
-    #pragma omp parallel  // Cette directive indique que le code suivant doit être exécuté en parallèle par plusieurs threads.
-    
-    {
-        map<Position, int> localVoisins; // Chaque thread a sa propre copie locale
-        #pragma omp for nowait
-        for (size_t i = 0; i < cellulesVivantes.size(); ++i) {
-            auto it = next(cellulesVivantes.begin(), i);
-            notifierVoisines(*it, localVoisins);
-        }
-
-        #pragma omp critical // Permet qu’un seul thread à la fois exécute un bloc de code. Evite les conflits des threads
-        for (const auto& [pos, count] : localVoisins) {
-            voisins[pos] += count; // Fusionne les résultats locaux dans le tableau global
-        }
+    // Table de la règle (état, nombre de voisins) -> nouvel état : aucun appel virtuel dans la boucle
+    uint8_t table[2][9];
+    for (int n = 0; n <= 8; ++n) {
+        table[0][n] = application(false, n);
+        table[1][n] = application(true, n);
     }
 
-    set<Position> nouvellesCellulesVivantes; // Ensemble des nouvelles cellules vivantes
-
-    // Applique les règles du jeu aux cellules ayant des voisins
-    #pragma omp parallel for // Cette directive divise automatiquement les itérations d'une boucle entre les threads.
-    for (auto it = voisins.begin(); it != voisins.end(); ++it) {
-        const auto& [pos, count] = *it;
-        bool estVivante = grille[pos.getX()][pos.getY()];
-        if (application(estVivante, count)) {
-            #pragma omp critical
-            nouvellesCellulesVivantes.insert(pos); // Ajoute les cellules qui deviennent vivantes
+    remplirHalo(); // Les bords du tore sont recopiés dans le halo
+
+    // Chaque thread calcule une bande de lignes contiguës et l'empreinte des cellules qui y changent d'état ;
+    // les empreintes des bandes sont combinées (OU exclusif) par la réduction : la seule synchronisation est
+    // la barrière de fin de boucle
+    long long nouvellePopulation = 0;
+    uint64_t changeA = 0, changeB = 0;
+    const uint8_t* c = cellules.data();
+    uint8_t* s = suivantes.data();
+    #pragma omp parallel for schedule(static) reduction(+:nouvellePopulation) reduction(^:changeA, changeB)
+    for (int i = 1; i <= dim1; ++i) {
+        const uint8_t* haut = c + (size_t)(i - 1) * largeur;
+        const uint8_t* milieu = c + (size_t)i * largeur;
+        const uint8_t* bas = c + (size_t)(i + 1) * largeur;
+        uint8_t* sortie = s + (size_t)i * largeur;
+        long long vivantes = 0;
+        for (int j = 1; j <= dim2; ++j) {
+            int voisins = haut[j - 1] + haut[j] + haut[j + 1] + milieu[j - 1] + milieu[j + 1] + bas[j - 1] + bas[j] + bas[j + 1];
+            sortie[j] = table[milieu[j]][voisins];
+            vivantes += sortie[j];
         }
+        nouvellePopulation += vivantes;
+
+        // Cellules de la ligne qui basculent, comparées 8 par 8 ; la fin de ligne octet par octet, car la ligne
+        // suivante de sortie est écrite en même temps par un autre thread
+        Empreinte ligne;
+        int j = 1;
+        for (; j + 7 <= dim2; j += 8) {
+            uint64_t avant, apres;
+            memcpy(&avant, milieu + j, 8);
+            memcpy(&apres, sortie + j, 8);
+            uint64_t differences = avant ^ apres; // Un bit par cellule basculée (bit 0 de son octet)
+            for (; differences; differences &= differences - 1) ligne.basculer(cleCellule(i - 1, j - 1 + __builtin_ctzll(differences) / 8));
+        }
+        for (; j <= dim2; ++j) {
+            if (milieu[j] != sortie[j]) ligne.basculer(cleCellule(i - 1, j - 1));
+        }
+        changeA ^= ligne.a;
+        changeB ^= ligne.b;
     }
 
-    // Met à jour la grille avec les nouvelles cellules vivantes
-    grille.assign(dim1, vector<bool>(dim2, false)); // Réinitialise la grille
-    #pragma omp parallel for
-    for (auto it = nouvellesCellulesVivantes.begin(); it != nouvellesCellulesVivantes.end(); ++it) {
-        const auto& pos = *it;
-        grille[pos.getX()][pos.getY()] = true; // Active les cellules vivantes
-    }
-    cellulesVivantes = nouvellesCellulesVivantes; // Met à jour l'ensemble des cellules vivantes
-
-    // Vérifie si la configuration est répétée
-    string currentConfiguration = getConfigurationString();
-    if (configurations.count(currentConfiguration)) return false; // Si la configuration est identique, la grille est stabilisée
+    cellules.swap(suivantes); // Échange des tampons : aucune copie
+    population = nouvellePopulation;
+    empreinte.a ^= changeA;
+    empreinte.b ^= changeB;
 
-    configurations.insert(currentConfiguration); // Ajoute la nouvelle configuration à l'historique
-    return true; // La grille a évolué
+    // Vérifie si la configuration est répétée (empreinte de 128 bits : une collision est négligeable)
+    return memoriser(); // Faux : configuration déjà vue, la grille est stabilisée
 }
-    
-    
 
     // **Sauvegarde une itération dans un fichier**
     void saveIteration(int iteration, const string& folderPath) {
@@ -203,13 +228,13 @@ public:
 
         // Écrit les informations dans le fichier
         file << "Iteration: " << iteration << "\n";
-        file << "Cellules vivantes: " << cellulesVivantes.size() << "\n";
+        file << "Cellules vivantes: " << population << "\n";
         file << "Dimensions: " << dim1 << "x" << dim2 << "\n";
 
         // Écrit l'état de la grille ligne par ligne
         for (int i = 0; i < dim1; ++i) {
             for (int j = 0; j < dim2; ++j) {
-                file << (grille[i][j] ? "1 " : "0 "); // Écrit '1' pour vivante, '0' pour morte
+                file << (estVivante(i, j) ? "1 " : "0 "); // Écrit '1' pour vivante, '0' pour morte
             }
             file << "\n";
         }
@@ -223,13 +248,13 @@ public:
 
         // Écrit les informations de stabilisation
         file << "Stabilisation à l'iteration: " << iteration << "\n";
-        file << "Cellules vivantes: " << cellulesVivantes.size() << "\n";
+        file << "Cellules vivantes: " << population << "\n";
         file << "Dimensions: " << dim1 << "x" << dim2 << "\n";
 
         // Écrit l'état de la grille ligne par ligne
         for (int i = 0; i < dim1; ++i) {
             for (int j = 0; j < dim2; ++j) {
-                file << (grille[i][j] ? "1 " : "0 ");
+                file << (estVivante(i, j) ? "1 " : "0 ");
             }
             file << "\n";
         }
@@ -243,7 +268,7 @@ public:
         // Dessine les cellules vivantes
         for (int i = 0; i < dim1; ++i) {
             for (int j = 0; j < dim2; ++j) {
-                if (grille[i][j]) {
+                if (estVivante(i, j)) {
                     sf::RectangleShape cell(sf::Vector2f(pixelSize - 1, pixelSize - 1)); // Crée une cellule de taille spécifiée
                     cell.setPosition(j * pixelSize, i * pixelSize); // Positionne la cellule sur la grille
                     cell.setFillColor(sf::Color::White); // Définit la couleur de la cellule (blanc pour vivante)